@@ -0,0 +1,135 @@
+// Misma carga de /register, /login y /users contra cada motor de UserStore.
+// Uso: bench_backends [usuarios] [hilos] [motor]
+//   motor: nombre de un único motor a ejecutar (por defecto, todos)
+//   BENCH_PG_URL=postgresql://... añade PostgreSQL (tabla bench_users, se vacía)
+
+#include "bench_util.h"
+#include "compact_user_store.h"
+#include "id_allocator.h"
+#include "logged_user_store.h"
+#include "memory_user_store.h"
+#include "pg_user_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Backend {
+    const char* name;
+    std::function<std::unique_ptr<UserStore>()> make;
+};
+
+std::vector<Backend> backends(unsigned threads) {
+    std::vector<Backend> list = {
+        {"memory", [] { return std::make_unique<MemoryUserStore>(); }},
+        {"compact", [] { return std::make_unique<CompactUserStore>(); }},
+        {"memory+log", [threads] {
+            std::remove("bench_backends.log");
+            return std::make_unique<LoggedUserStore>("bench_backends.log", "", threads);
+        }},
+    };
+    if (const char* url = std::getenv("BENCH_PG_URL")) {
+        list.push_back({"postgres", [url, threads] {
+            auto store = std::make_unique<PgUserStore>(url, threads, "bench_users");
+            store->truncate();
+            return std::unique_ptr<UserStore>(std::move(store));
+        }});
+    }
+    return list;
+}
+
+// Estadísticas propias de cada motor, si las tiene
+void print_backend_stats(const UserStore& store) {
+    if (const auto* pg = dynamic_cast<const PgUserStore*>(&store)) {
+        const PgUserStore::Stats s = pg->stats();
+        const double acquisitions = s.pool.acquisitions ? static_cast<double>(s.pool.acquisitions) : 1.0;
+        const double queries = s.queries ? static_cast<double>(s.queries) : 1.0;
+        std::printf("    pool: espera media %.1f us, máxima %.1f us | consulta media %.1f us (%llu consultas)\n",
+                    s.pool.wait_ns_total / acquisitions / 1e3, s.pool.wait_ns_max / 1e3,
+                    s.query_ns_total / queries / 1e3, static_cast<unsigned long long>(s.queries));
+    }
+}
+
+template <typename Fn>
+double run_threads(unsigned threads, Fn&& fn) {
+    std::vector<std::thread> workers;
+    Stopwatch sw;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(fn, t);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return sw.elapsed_s();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t users = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const unsigned threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const char* only = argc > 3 ? argv[3] : nullptr;
+    const std::size_t logins = users * 2;
+    const std::size_t page_size = 1000;
+
+    std::printf("%d usuarios, %u hilos\n", static_cast<int>(users), threads);
+    std::printf("%-12s %14s %14s %14s\n", "motor", "registros/s", "logins/s", "listado/s");
+
+    for (const auto& backend : backends(threads)) {
+        if (only && std::strcmp(only, backend.name) != 0) {
+            continue;
+        }
+        auto store = backend.make();
+        IdAllocator ids(store->max_id() + 1);
+
+        // /register: cada hilo registra su tramo de usernames
+        std::atomic<std::size_t> conflicts{0};
+        double reg_s = run_threads(threads, [&](unsigned t) {
+            for (std::size_t i = t; i < users; i += threads) {
+                if (!store->insert_if_absent(User{bench_username(i), "secreto", ids.next()})) {
+                    conflicts.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        // /login: búsqueda por username + comprobación de password
+        std::atomic<std::size_t> failed{0};
+        double login_s = run_threads(threads, [&](unsigned t) {
+            XorShift64 rng{0x5151ull + t};
+            for (std::size_t i = t; i < logins; i += threads) {
+                auto user = store->find_by_username(bench_username(rng.next() % users));
+                if (!user || user->password != "secreto") {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        // /users: recorrido completo por páginas
+        Stopwatch sw;
+        std::size_t listed = 0;
+        int last_id = 0;
+        for (auto page = store->page(last_id, page_size); !page.empty(); page = store->page(last_id, page_size)) {
+            listed += page.size();
+            last_id = page.back().id;
+        }
+        double list_s = sw.elapsed_s();
+
+        std::printf("%-12s %14.0f %14.0f %14.0f\n", backend.name, users / reg_s, logins / login_s, listed / list_s);
+        print_backend_stats(*store);
+        if (conflicts.load() != 0 || failed.load() != 0 || listed != users) {
+            std::fprintf(stderr, "❌ %s: %zu conflictos, %zu logins fallidos, %zu listados\n", backend.name,
+                         conflicts.load(), failed.load(), listed);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Base64url: núcleo escalar frente a SSSE3 y AVX2 con tamaños de JWT.
+// Uso: bench_base64url [casos_fuzz]   (por defecto 200k)
+//
+// Antes de medir compara los núcleos con entradas aleatorias: misma
+// codificación y, al decodificar (también texto corrupto o truncado), mismo
+// veredicto y mismos bytes; lo que se acepta debe volver a codificarse igual
+// (sólo hay un texto válido por cada secuencia de bytes). Después mide ns por token de 200-400 caracteres
+// (header + payload + firma) codificando y decodificando.
+
+#include "base64url.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+const Base64Kernel kKernels[] = {Base64Kernel::Scalar, Base64Kernel::Ssse3, Base64Kernel::Avx2};
+
+std::string random_bytes(XorShift64& rng, std::size_t size) {
+    std::string data(size, '\0');
+    for (char& c : data) {
+        c = static_cast<char>(rng.next());
+    }
+    return data;
+}
+
+// Texto a decodificar: válido, con un byte cambiado, truncado, de caracteres
+// mezclados (dentro y fuera del alfabeto) o con otro último carácter del alfabeto
+std::string mutate(XorShift64& rng, std::string text) {
+    static constexpr char kMix[] = "AZaz09-_+/= \x80\xff";
+    static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    switch (rng.next() % 5) {
+        case 1:
+            if (!text.empty()) {
+                text[rng.next() % text.size()] = static_cast<char>(rng.next());
+            }
+            break;
+        case 2:
+            text.resize(text.empty() ? 0 : rng.next() % text.size());
+            break;
+        case 3:
+            for (char& c : text) {
+                c = kMix[rng.next() % (sizeof(kMix) - 1)];
+            }
+            break;
+        case 4:
+            if (!text.empty()) {
+                text.back() = kAlphabet[rng.next() % (sizeof(kAlphabet) - 1)];
+            }
+            break;
+    }
+    return text;
+}
+
+bool fuzz(std::size_t cases, std::vector<Base64Kernel>& kernels) {
+    XorShift64 rng;
+    for (std::size_t i = 0; i < cases; ++i) {
+        const std::string data = random_bytes(rng, rng.next() % 512);
+        std::string reference;
+        base64url_set_kernel(Base64Kernel::Scalar);
+        base64url_encode(data.data(), data.size(), reference);
+        const std::string text = mutate(rng, reference);
+        std::string expected;
+        const bool expected_ok = base64url_decode(text, expected);
+
+        for (const Base64Kernel kernel : kernels) {
+            base64url_set_kernel(kernel);
+            std::string encoded, decoded, reencoded;
+            base64url_encode(data.data(), data.size(), encoded);
+            const bool ok = base64url_decode(text, decoded);
+            if (encoded != reference || ok != expected_ok || (ok && decoded != expected)) {
+                std::printf("❌ %s distinto del escalar (%zu bytes, texto de %zu)\n", base64url_kernel_name(kernel),
+                            data.size(), text.size());
+                return false;
+            }
+            if (ok) {
+                base64url_encode(decoded.data(), decoded.size(), reencoded);
+                if (reencoded != text) {
+                    std::printf("❌ %s acepta un texto no canónico (texto de %zu)\n", base64url_kernel_name(kernel),
+                                text.size());
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t cases = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    const Base64Kernel best = base64url_kernel();
+
+    std::vector<Base64Kernel> kernels;
+    for (const Base64Kernel kernel : kKernels) {
+        if (base64url_set_kernel(kernel)) {
+            kernels.push_back(kernel);
+        }
+    }
+    if (!fuzz(cases, kernels)) {
+        return 1;
+    }
+    std::printf("equivalencia: %zu casos, núcleos:", cases);
+    for (const Base64Kernel kernel : kernels) {
+        std::printf(" %s", base64url_kernel_name(kernel));
+    }
+    std::printf(" (por defecto %s)\n", base64url_kernel_name(best));
+
+    // Partes de un token: header (~40 bytes), payload (100-240) y firma HS256 (32)
+    const std::size_t tokens = 4096;
+    XorShift64 rng;
+    std::vector<std::string> parts;
+    std::size_t token_chars = 0;
+    for (std::size_t i = 0; i < tokens; ++i) {
+        for (const std::size_t size : {std::size_t{40}, std::size_t{100 + rng.next() % 141}, std::size_t{32}}) {
+            parts.push_back(random_bytes(rng, size));
+            token_chars += base64url_encoded_size(size) + 1;
+        }
+    }
+    std::vector<std::string> encoded(parts.size());
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        base64url_encode(parts[i].data(), parts[i].size(), encoded[i]);
+    }
+    std::printf("tokens de %zu caracteres de media\n", token_chars / tokens);
+
+    const int rounds = 200;
+    std::printf("%8s %16s %16s\n", "núcleo", "encode ns/token", "decode ns/token");
+    for (const Base64Kernel kernel : kernels) {
+        base64url_set_kernel(kernel);
+        std::string out;
+        Stopwatch sw;
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& part : parts) {
+                out.clear();
+                base64url_encode(part.data(), part.size(), out);
+                do_not_optimize(out.data());
+            }
+        }
+        const double encode_ns = sw.elapsed_ns() / (rounds * tokens);
+
+        sw.reset();
+        for (int r = 0; r < rounds; ++r) {
+            for (const auto& text : encoded) {
+                out.clear();
+                do_not_optimize(base64url_decode(text, out));
+            }
+        }
+        const double decode_ns = sw.elapsed_ns() / (rounds * tokens);
+        std::printf("%8s %16.1f %16.1f\n", base64url_kernel_name(kernel), encode_ns, decode_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+// Memoria por usuario y latencia de búsqueda: CompactUserStore (columnas +
+// arena) frente a MemoryUserStore (User con dos std::string + índices).
+// Uso: bench_compact_store [usuarios]   (por defecto 1M)
+//
+// La memoria se mide contando los bytes pedidos a operator new, así que
+// incluye la cabecera de cada std::string, los nodos de unordered_map, etc.
+// Después mide la cola de latencia de /login mientras otro hilo da de alta
+// otros tantos usuarios (los redimensionados ocurren bajo el lock del shard).
+
+#include "bench_util.h"
+#include "compact_user_store.h"
+#include "memory_user_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> g_live_bytes{0};
+
+// Usernames con aspecto de correo: superan el SSO de std::string (15 bytes)
+std::string long_username(std::uint64_t i) {
+    return "usuario" + std::to_string(i) + "@transmi.example";
+}
+
+struct Sample {
+    double bytes_per_user;
+    double login_ns;
+    double id_ns;
+};
+
+template <typename Store, typename Lookup>
+Sample measure(std::size_t count, Lookup lookup) {
+    const long long before = g_live_bytes.load();
+    Store store;
+    for (std::size_t i = 0; i < count; ++i) {
+        store.insert_if_absent(User{long_username(i), "secreto123", static_cast<int>(i + 1)});
+    }
+    const double bytes = static_cast<double>(g_live_bytes.load() - before) / count;
+
+    const std::size_t lookups = 1'000'000;
+    XorShift64 rng;
+    std::vector<std::string> names(lookups);
+    std::vector<int> ids(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        std::uint64_t k = rng.next() % count;
+        names[i] = long_username(k);
+        ids[i] = static_cast<int>(k + 1);
+    }
+
+    Stopwatch sw;
+    for (const auto& name : names) {
+        do_not_optimize(lookup(store, name));
+    }
+    const double login = sw.elapsed_ns() / lookups;
+
+    sw.reset();
+    for (int id : ids) {
+        do_not_optimize(lookup(store, id));
+    }
+    const double by_id = sw.elapsed_ns() / lookups;
+    return Sample{bytes, login, by_id};
+}
+
+struct Tail {
+    std::size_t logins;
+    double p50_us;
+    double p99_us;
+    double p999_us;
+    double max_us;
+};
+
+// /login (find_by_username) en bucle contra los `count` primeros usuarios
+// mientras otro hilo inserta `count` más; cada búsqueda se cronometra aparte
+template <typename Store>
+Tail login_tail_during_inserts(std::size_t count) {
+    Store store;
+    for (std::size_t i = 0; i < count; ++i) {
+        store.insert_if_absent(User{long_username(i), "secreto123", static_cast<int>(i + 1)});
+    }
+    XorShift64 rng;
+    std::vector<std::string> names(1 << 16);
+    for (auto& name : names) {
+        name = long_username(rng.next() % count);
+    }
+    std::vector<double> samples;
+    samples.reserve(1 << 23);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (std::size_t i = count; i < 2 * count; ++i) {
+            store.insert_if_absent(User{long_username(i), "secreto123", static_cast<int>(i + 1)});
+        }
+        done = true;
+    });
+    for (std::size_t i = 0; !done.load(std::memory_order_relaxed) && samples.size() < samples.capacity(); ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        do_not_optimize(store.find_by_username(names[i % names.size()]));
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    writer.join();
+
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&](double q) {
+        const auto index = static_cast<std::size_t>(q * samples.size());
+        return samples.empty() ? 0.0 : samples[std::min(samples.size() - 1, index)];
+    };
+    return Tail{samples.size(), at(0.5), at(0.99), at(0.999), samples.empty() ? 0.0 : samples.back()};
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    // Cabecera de 16 bytes con el tamaño, para descontarlo en delete
+    void* block = std::malloc(size + 16);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    g_live_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + 16;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        char* block = static_cast<char*>(ptr) - 16;
+        g_live_bytes.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t*>(block)),
+                               std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    // Las búsquedas devuelven una copia (lo que hace /login) en ambos motores
+    const Sample memory = measure<MemoryUserStore>(count, [](const MemoryUserStore& s, const auto& key) {
+        using Key = std::decay_t<decltype(key)>;
+        if constexpr (std::is_same_v<Key, int>) {
+            return s.find_by_id(key);
+        } else {
+            return s.find_by_username(key);
+        }
+    });
+    const Sample compact = measure<CompactUserStore>(count, [](const CompactUserStore& s, const auto& key) {
+        using Key = std::decay_t<decltype(key)>;
+        if constexpr (std::is_same_v<Key, int>) {
+            return s.find_by_id(key);
+        } else {
+            return s.find_by_username(key);
+        }
+    });
+
+    std::printf("%zu usuarios (username de ~28 bytes, password de 10)\n", count);
+    std::printf("%-10s %14s %14s %14s\n", "motor", "bytes/usuario", "login ns/op", "id ns/op");
+    std::printf("%-10s %14.1f %14.1f %14.1f\n", "memory", memory.bytes_per_user, memory.login_ns, memory.id_ns);
+    std::printf("%-10s %14.1f %14.1f %14.1f\n", "compact", compact.bytes_per_user, compact.login_ns, compact.id_ns);
+
+    std::printf("\n/login con %zu altas concurrentes (µs por búsqueda)\n", count);
+    std::printf("%-10s %10s %10s %10s %10s %10s\n", "motor", "logins", "p50", "p99", "p99.9", "max");
+    const auto tail_row = [](const char* name, const Tail& tail) {
+        std::printf("%-10s %10zu %10.2f %10.2f %10.2f %10.1f\n", name, tail.logins, tail.p50_us, tail.p99_us,
+                    tail.p999_us, tail.max_us);
+    };
+    tail_row("memory", login_tail_during_inserts<MemoryUserStore>(count));
+    tail_row("compact", login_tail_during_inserts<CompactUserStore>(count));
+    return 0;
+}
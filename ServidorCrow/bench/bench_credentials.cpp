@@ -0,0 +1,183 @@
+// Lectura del body de /register y /login: json::parse vs CredentialsParser.
+// Uso: bench_credentials [iteraciones] [casos_fuzz]   (por defecto 2M y 200k)
+//
+// Antes de medir comprueba que el parser da el mismo veredicto que nlohmann
+// (JSON inválido, campos ausentes, campos que no son strings) y los mismos
+// valores, con un corpus de casos raros y mutaciones aleatorias de él.
+
+#include "bench_util.h"
+#include "credentials_request.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Status = CredentialsParser::Status;
+
+// Lo que hacían los handlers: parse, contains y conversión a std::string
+Status nlohmann_parse(const std::string& body, std::string& username, std::string& password) {
+    try {
+        nlohmann::json request_data = nlohmann::json::parse(body);
+        if (!request_data.contains("username") || !request_data.contains("password")) {
+            return Status::Missing;
+        }
+        username = request_data["username"];
+        password = request_data["password"];
+        return Status::Ok;
+    } catch (const nlohmann::json::type_error&) {
+        return Status::NotString;
+    } catch (const nlohmann::json::exception&) {
+        return Status::Malformed;
+    }
+}
+
+const std::vector<std::string> kCorpus = {
+    R"({"username":"juan","password":"secreto"})",
+    " \t\r\n{ \"password\" : \"p\" , \"username\" : \"u\" } \n",
+    "\xEF\xBB\xBF{\"username\":\"u\",\"password\":\"p\"}",
+    "\xEF\xBB{\"username\":\"u\",\"password\":\"p\"}",
+    R"({"username":"a\"b\\c\/d\b\f\n\r\t","password":"ñé🚀\u0000"})",
+    R"({"username":"u","password":"p"})",
+    R"({"username":"\ud83d","password":"p"})",
+    R"({"username":"\ude80","password":"p"})",
+    R"({"username":"\ud83dA","password":"p"})",
+    R"({"username":"\x","password":"p"})",
+    R"({"username":"\u12G4","password":"p"})",
+    "{\"username\":\"ñandú 🚀\",\"password\":\"p\"}",
+    "{\"username\":\"\xC0\xAF\",\"password\":\"p\"}",
+    "{\"username\":\"\xED\xA0\x80\",\"password\":\"p\"}",
+    "{\"username\":\"\xF4\x90\x80\x80\",\"password\":\"p\"}",
+    "{\"username\":\"\xE2\x82\",\"password\":\"p\"}",
+    "{\"username\":\"tab\there\",\"password\":\"p\"}",
+    R"({"username":"u","password":"p","extra":{"a":[1,-2.5e3,true,false,null,{}],"b":[]}})",
+    R"({"username":"u","password":"p","n":1e999})",
+    R"({"username":"u","password":"p","n":-1e308})",
+    R"({"username":"u","password":"p","n":01})",
+    R"({"username":"u","password":"p","n":1.})",
+    R"({"username":"u","password":"p","n":-})",
+    R"({"username":"u","password":"p","n":1e+})",
+    R"({"username":"u","password":"p","n":tru})",
+    R"({"username":1,"password":"p"})",
+    R"({"username":null,"password":"p"})",
+    R"({"username":["u"],"password":{"p":1}})",
+    R"({"username":"u"})",
+    R"({"password":"p"})",
+    R"({"username":"u","username":"v","password":"p"})",
+    R"({"username":1,"username":"v","password":"p"})",
+    R"({"username":"v","username":1,"password":"p"})",
+    R"({"username":"u","password":"p"} x)",
+    R"({"username":"u","password":"p",})",
+    R"({"username":"u" "password":"p"})",
+    R"({"username":"u","password":"p")",
+    R"(["username","password"])",
+    R"("username")",
+    "42",
+    "null",
+    "{}",
+    "",
+    "   ",
+    R"({"a":[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]],"username":"u","password":"p"})",
+    R"({"a":[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]],"username":"u","password":"p"})",
+    R"({"a":{"b":{"c":[{"d":"e"}]}},"username":"u","password":"p"})",
+    R"({"a":{"b" "c"},"username":"u","password":"p"})",
+    R"({"a":{1:2},"username":"u","password":"p"})",
+    std::string(R"({"username":"u","password":"p"})") + '\0' + "basura",
+};
+
+// Caracteres con los que mutar: estructura JSON, escapes, números y UTF-8 suelto
+const std::string kMutations = "{}[]:,\"\\/ unbtfrexE+-.0123456789aAdDlsF\xC3\xA9\xED\xF0\x80\xBF\xEF";
+
+std::string mutate(XorShift64& rng, std::string body) {
+    const int edits = 1 + rng.next() % 3;
+    for (int e = 0; e < edits; ++e) {
+        const std::size_t at = body.empty() ? 0 : rng.next() % (body.size() + 1);
+        const char c = kMutations[rng.next() % kMutations.size()];
+        switch (rng.next() % 4) {
+            case 0:
+                if (at < body.size()) {
+                    body[at] = c;
+                }
+                break;
+            case 1:
+                body.insert(body.begin() + at, c);
+                break;
+            case 2:
+                if (at < body.size()) {
+                    body.erase(at, 1);
+                }
+                break;
+            case 3:
+                body.resize(at);
+                break;
+        }
+    }
+    return body;
+}
+
+bool check(CredentialsParser& parser, const std::string& body) {
+    std::string username, password;
+    const Status expected = nlohmann_parse(body, username, password);
+    Credentials credentials;
+    const Status status = parser.parse(body, credentials);
+    if (status != expected ||
+        (status == Status::Ok && (credentials.username != username || credentials.password != password))) {
+        std::printf("❌ distinto de nlohmann (%d vs %d) con: %s\n", static_cast<int>(status),
+                    static_cast<int>(expected), body.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const std::size_t cases = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200'000;
+
+    CredentialsParser parser;
+    for (const auto& body : kCorpus) {
+        if (!check(parser, body)) {
+            return 1;
+        }
+    }
+    XorShift64 rng;
+    std::size_t verdicts[4] = {};
+    for (std::size_t i = 0; i < cases; ++i) {
+        const std::string body = mutate(rng, kCorpus[rng.next() % kCorpus.size()]);
+        if (!check(parser, body)) {
+            return 1;
+        }
+        Credentials ignored;
+        ++verdicts[static_cast<int>(parser.parse(body, ignored))];
+    }
+    std::printf("equivalencia: %zu casos del corpus + %zu mutaciones (ok %zu, inválidos %zu, ausentes %zu, "
+                "no string %zu)\n", kCorpus.size(), cases, verdicts[0], verdicts[1], verdicts[2], verdicts[3]);
+
+    const std::string bodies[] = {
+        R"({"username":"usuario_de_prueba","password":"una_password_bastante_larga_123"})",
+        R"({"username": "mañana", "password": "con \"comillas\"", "recordar": true})",
+    };
+    for (const auto& body : bodies) {
+        Stopwatch sw;
+        for (std::size_t i = 0; i < iterations / 4; ++i) {
+            std::string username, password;
+            do_not_optimize(nlohmann_parse(body, username, password));
+            do_not_optimize(username.data());
+        }
+        const double dom_ns = sw.elapsed_ns() / (iterations / 4);
+        sw.reset();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            Credentials credentials;
+            do_not_optimize(parser.parse(body, credentials));
+            do_not_optimize(credentials);
+        }
+        std::printf("%s\n  json::parse %.1f ns, CredentialsParser %.1f ns\n", body.c_str(), dom_ns,
+                    sw.elapsed_ns() / iterations);
+    }
+    return 0;
+}
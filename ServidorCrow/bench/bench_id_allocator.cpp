@@ -0,0 +1,71 @@
+// Coste de asignar ids de 1 a N hilos: un atomic compartido frente a IdAllocator.
+// Uso: bench_id_allocator [ids_por_hilo] [max_hilos]
+
+#include "bench_util.h"
+#include "id_allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Fn>
+double run_threads(unsigned threads, Fn&& fn) {
+    std::vector<std::thread> workers;
+    Stopwatch sw;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(fn);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    return sw.elapsed_ns();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const unsigned max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("%8s %18s %18s %10s\n", "hilos", "atomic ns/id", "IdAllocator ns/id", "únicos");
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        alignas(64) std::atomic<int> shared{1};
+        double atomic_ns = run_threads(threads, [&] {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                do_not_optimize(shared.fetch_add(1, std::memory_order_relaxed));
+            }
+        });
+
+        IdAllocator allocator;
+        std::vector<std::vector<int>> seen(threads);
+        std::atomic<unsigned> slot{0};
+        double block_ns = run_threads(threads, [&] {
+            auto& mine = seen[slot.fetch_add(1)];
+            mine.reserve(per_thread);
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                mine.push_back(allocator.next());
+            }
+        });
+
+        // Verificar unicidad de todos los ids repartidos
+        std::vector<int> all;
+        for (auto& ids : seen) {
+            all.insert(all.end(), ids.begin(), ids.end());
+        }
+        std::sort(all.begin(), all.end());
+        bool unique = std::adjacent_find(all.begin(), all.end()) == all.end();
+
+        const double total = static_cast<double>(per_thread) * threads;
+        std::printf("%8u %18.2f %18.2f %10s\n", threads, atomic_ns / total, block_ns / total, unique ? "sí" : "NO");
+        if (!unique) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+// Coste de firmar y verificar por algoritmo (HS256, ES256, EdDSA), para
+// elegir la clave activa. Antes de medir comprueba que jwt-cpp acepta las
+// firmas ES256/EdDSA generadas aquí con sólo la clave pública y que una clave
+// EC de otra curva de 256 bits no se acepta como ES256.
+// Uso: bench_jwt_algorithms [iteraciones]   (por defecto 20k)
+
+#include "bench_util.h"
+#include "evp_signer.h"
+#include "hs256_signer.h"
+
+#include <jwt-cpp/jwt.h>
+#include <openssl/ec.h>
+#include <openssl/pem.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Par de claves nuevo: EVP_PKEY_EC (P-256 salvo otra curva) o EVP_PKEY_ED25519
+EVP_PKEY* generate_key(int type, int curve = NID_X9_62_prime256v1) {
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(type, nullptr);
+    EVP_PKEY* key = nullptr;
+    const bool ok = ctx && EVP_PKEY_keygen_init(ctx) == 1 &&
+                    (type != EVP_PKEY_EC || EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, curve) == 1) &&
+                    EVP_PKEY_keygen(ctx, &key) == 1;
+    EVP_PKEY_CTX_free(ctx);
+    if (!ok) {
+        throw std::runtime_error("no se pudo generar la clave");
+    }
+    return key;
+}
+
+std::string public_pem(EVP_PKEY* key) {
+    BIO* bio = BIO_new(BIO_s_mem());
+    PEM_write_bio_PUBKEY(bio, key);
+    char* data = nullptr;
+    const long size = BIO_get_mem_data(bio, &data);
+    std::string pem(data, static_cast<std::size_t>(size));
+    BIO_free(bio);
+    return pem;
+}
+
+// Token firmado por el firmante propio y verificado por jwt-cpp
+template <typename JwtAlgorithm>
+bool jwt_cpp_accepts(const TokenSigner& signer, const JwtAlgorithm& verifier) {
+    const std::string token = jwt::create()
+                                  .set_issuer("auth.transmi")
+                                  .set_type("JWS")
+                                  .set_payload_claim("username", jwt::claim(std::string("user1")))
+                                  .sign(signer);
+    try {
+        jwt::verify().allow_algorithm(verifier).with_issuer("auth.transmi").verify(jwt::decode(token));
+        return true;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "❌ jwt-cpp rechaza %s: %s\n", signer.alg(), e.what());
+        return false;
+    }
+}
+
+void measure(const TokenSigner& signer, std::size_t iterations) {
+    // Entrada típica: header.payload en base64url (~200 bytes)
+    const std::string input(200, 'e');
+    unsigned char signature[TokenSigner::kMaxSignatureSize];
+
+    Stopwatch sw;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        signer.sign(input.data(), input.size(), signature);
+        do_not_optimize(signature[0]);
+    }
+    const double sign_ns = sw.elapsed_ns() / iterations;
+
+    sw.reset();
+    std::size_t valid = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        valid += signer.verify(input.data(), input.size(), signature, signer.signature_size());
+    }
+    const double verify_ns = sw.elapsed_ns() / iterations;
+    if (valid != iterations) {
+        std::fprintf(stderr, "❌ %s: la verificación falló\n", signer.alg());
+        std::exit(1);
+    }
+
+    std::printf("%-8s %12.1f %12.0f %12.1f %12.0f\n", signer.alg(), sign_ns / 1e3, 1e9 / sign_ns, verify_ns / 1e3,
+                1e9 / verify_ns);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000;
+
+    Hs256Signer hs256("mi_secreto_super_seguro");
+    EvpSigner es256(generate_key(EVP_PKEY_EC));
+    EvpSigner eddsa(generate_key(EVP_PKEY_ED25519));
+
+    if (!jwt_cpp_accepts(es256, jwt::algorithm::es256(public_pem(es256.key()))) ||
+        !jwt_cpp_accepts(eddsa, jwt::algorithm::ed25519(public_pem(eddsa.key())))) {
+        return 1;
+    }
+    try {
+        EvpSigner secp256k1(generate_key(EVP_PKEY_EC, NID_secp256k1));
+        std::fprintf(stderr, "❌ clave secp256k1 aceptada como ES256\n");
+        return 1;
+    } catch (const std::invalid_argument&) {
+    }
+
+    std::printf("%-8s %12s %12s %12s %12s\n", "alg", "firma us", "firmas/s", "verif. us", "verif./s");
+    measure(hs256, iterations);
+    measure(es256, iterations);
+    measure(eddsa, iterations);
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Coste de firmar tokens: jwt::algorithm::hs256 construido por petición (lo
+// que hacían los handlers) frente a Hs256Signer/TokenService compartidos.
+// Antes de medir comprueba que TokenService emite exactamente los mismos
+// bytes que jwt::create() para usernames con caracteres que se escapan.
+// Uso: bench_jwt_sign [iteraciones]   (por defecto 1M)
+
+#include "bench_util.h"
+#include "hs256_signer.h"
+#include "token_service.h"
+
+#include <jwt-cpp/jwt.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+const std::string kKey = "mi_secreto_super_seguro";
+const std::string kJti = "n0D9-xYj_2Qk3bVt8sLwAg";
+
+// Entrada típica de HS256: header.payload en base64url (~170 bytes)
+const std::string kSigningInput =
+    "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXUyJ9."
+    "eyJleHAiOjE3MDAwMDAwMDAsImlzcyI6ImF1dGgudHJhbnNtaSIsInVzZXJfaWQiOiIxMjM0NTYiLCJ1c2VybmFtZSI6InVzZXIxMjM0NTYifQ";
+
+// Token de referencia, construido como lo hacían los handlers
+std::string jwt_cpp_token(const KeyRing::Key& key, int user_id, const std::string& username, std::int64_t exp,
+                          const std::string& jti) {
+    return jwt::create()
+        .set_issuer("auth.transmi")
+        .set_type("JWS")
+        .set_key_id(key.kid)
+        .set_id(jti)
+        .set_payload_claim("user_id", jwt::claim(std::to_string(user_id)))
+        .set_payload_claim("username", jwt::claim(username))
+        .set_expires_at(std::chrono::system_clock::time_point(std::chrono::seconds(exp)))
+        .sign(*key.signer);
+}
+
+bool same_tokens_as_jwt_cpp(const TokenService& tokens) {
+    const std::string usernames[] = {
+        "user1", "a\"b\\c/d", "tab\tnl\ncr\rbs\bff\f", std::string("nul\0ctl\x01\x1f\x7f", 10), "ñandú_€_𝄞",
+    };
+    for (const auto& username : usernames) {
+        const std::string expected = jwt_cpp_token(*tokens.keys().current().active, 42, username, 1'700'000'000, kJti);
+        const std::string actual = tokens.issue(42, username, 1'700'000'000, kJti);
+        if (actual != expected) {
+            std::fprintf(stderr, "❌ Token distinto para %s:\n  jwt-cpp: %s\n  propio:  %s\n", username.c_str(),
+                         expected.c_str(), actual.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    std::error_code ec;
+
+    TokenService tokens(std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, kKey}});
+    if (!same_tokens_as_jwt_cpp(tokens)) {
+        return 1;
+    }
+
+    Stopwatch sw;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(jwt::algorithm::hs256{kKey}.sign(kSigningInput, ec));
+    }
+    const double hmac_before = sw.elapsed_ns() / iterations;
+
+    Hs256Signer signer(kKey);
+    unsigned char digest[Hs256Signer::kDigestSize];
+    sw.reset();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        signer.sign(kSigningInput.data(), kSigningInput.size(), digest);
+        do_not_optimize(digest[0]);
+    }
+    const double hmac_after = sw.elapsed_ns() / iterations;
+
+    sw.reset();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(jwt::create()
+                            .set_issuer("auth.transmi")
+                            .set_type("JWS")
+                            .set_payload_claim("user_id", jwt::claim(std::to_string(i)))
+                            .set_payload_claim("username", jwt::claim(bench_username(i)))
+                            .set_expires_at(std::chrono::system_clock::now() + std::chrono::hours{24})
+                            .sign(jwt::algorithm::hs256{kKey}));
+    }
+    const double token_before = sw.elapsed_ns() / iterations;
+
+    sw.reset();
+    const KeyRing::Key& key = *tokens.keys().current().active;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(jwt_cpp_token(key, static_cast<int>(i), bench_username(i), 1'700'000'000, kJti));
+    }
+    const double token_shared = sw.elapsed_ns() / iterations;
+
+    sw.reset();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(tokens.issue(static_cast<int>(i), bench_username(i)));
+    }
+    const double token_after = sw.elapsed_ns() / iterations;
+
+    std::printf("%-36s %12s\n", "", "ns/op");
+    std::printf("%-36s %12.1f\n", "HMAC: hs256 por petición", hmac_before);
+    std::printf("%-36s %12.1f\n", "HMAC: Hs256Signer", hmac_after);
+    std::printf("%-36s %12.1f\n", "token: jwt::create + hs256", token_before);
+    std::printf("%-36s %12.1f\n", "token: jwt::create + Hs256Signer", token_shared);
+    std::printf("%-36s %12.1f\n", "token: TokenService (plantilla)", token_after);
+    return 0;
+}
@@ -0,0 +1,98 @@
+// GET /me: verificación (caché del hilo) + cuerpo escrito desde los claims.
+// Uso: bench_me [iteraciones_por_hilo] [max_hilos]   (por defecto 2M)
+//
+// Comprueba que claims_response da los mismos bytes que nlohmann, compara su
+// coste y mide operaciones/s de 1 a N hilos con el MISMO token en todos (el
+// peor caso para cualquier estado compartido: locks, contadores, refcounts).
+
+#include "bench_util.h"
+#include "claims_response.h"
+#include "token_service.h"
+#include "token_verifier.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string nlohmann_response(const TokenClaims& claims) {
+    nlohmann::json response = {
+        {"success", true},
+        {"user", {
+            {"id", claims.user_id},
+            {"username", claims.username}
+        }},
+        {"exp", claims.expires_at}
+    };
+    return response.dump();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const unsigned max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    const std::string usernames[] = {"juan", "a/b", "com\"illas", "barra\\invertida", "tab\tnl\ncr\r",
+                                     std::string("ctl\x01\x1f\x7f", 6), "ñandú", "emoji 🚀", ""};
+    for (const auto& username : usernames) {
+        const TokenClaims claims{-42, username, 1735689600, "jti"};
+        if (claims_response(claims) != nlohmann_response(claims)) {
+            std::printf("❌ distinto de nlohmann para \"%s\":\n  %s\n  %s\n", username.c_str(),
+                        claims_response(claims).c_str(), nlohmann_response(claims).c_str());
+            return 1;
+        }
+    }
+
+    const TokenClaims claims{123456, "usuario_de_prueba", 1735689600, "jti"};
+    Stopwatch sw;
+    for (std::size_t i = 0; i < iterations / 4; ++i) {
+        do_not_optimize(nlohmann_response(claims));
+    }
+    const double dom_ns = sw.elapsed_ns() / (iterations / 4);
+    sw.reset();
+    for (std::size_t i = 0; i < iterations / 4; ++i) {
+        do_not_optimize(claims_response(claims));
+    }
+    std::printf("cuerpo de /me: nlohmann %.1f ns, claims_response %.1f ns\n", dom_ns,
+                sw.elapsed_ns() / (iterations / 4));
+
+    TokenService service(std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}});
+    const std::string token = service.issue(claims.user_id, claims.username);
+    TokenVerifier verifier(service.keys());
+
+    std::printf("%8s %14s %16s\n", "hilos", "ops/s", "ops/s por hilo");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<std::thread> workers;
+        std::atomic<bool> go{false};
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    auto result = verifier.verify(token);
+                    do_not_optimize(claims_response(*result.claims));
+                }
+            });
+        }
+        sw.reset();
+        go.store(true, std::memory_order_release);
+        for (auto& w : workers) {
+            w.join();
+        }
+        const double ops = iterations * threads / sw.elapsed_s();
+        std::printf("%8u %14.0f %16.0f\n", threads, ops, ops / threads);
+    }
+
+    const TokenVerifier::Stats s = verifier.stats();
+    std::printf("aciertos en la caché del hilo: %.2f%%\n", 100.0 * s.thread_hits / (s.hits + s.misses));
+    return 0;
+}
@@ -0,0 +1,179 @@
+// Caminos de rechazo (401, 409, 400) frente al de éxito, antes y ahora.
+// Uso: bench_reject_path [iteraciones] [usuarios]   (por defecto 500k y 100k)
+//
+// "Antes" es lo que hacían los handlers: json::parse del body y el error
+// construido con nlohmann y dump(). "Ahora": CredentialsParser y el cuerpo
+// precalculado de error_responses.h. Se comprueba antes que cada cuerpo de la
+// tabla es el que daba nlohmann, incluidos los del middleware (describe()).
+
+#include "bench_util.h"
+#include "credentials_request.h"
+#include "error_responses.h"
+#include "memory_user_store.h"
+#include "response_bodies.h"
+#include "session_store.h"
+#include "token_service.h"
+#include "token_verifier.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nlohmann::json;
+
+std::string nlohmann_error(const std::string& message) {
+    json error_response = {
+        {"success", false},
+        {"error", message}
+    };
+    return error_response.dump();
+}
+
+struct Server {
+    MemoryUserStore users;
+    TokenService tokens{std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}}};
+    SessionStore sessions;
+    CredentialsParser parser;
+};
+
+// /login como era: DOM de nlohmann para leer y para responder
+std::string login_before(Server& server, const std::string& body) {
+    json request_data = json::parse(body);
+    if (!request_data.contains("username") || !request_data.contains("password")) {
+        return nlohmann_error("Se requieren username y password");
+    }
+    std::string username = request_data["username"];
+    std::string password = request_data["password"];
+    auto user = server.users.find_by_username(username);
+    if (user && user->password == password) {
+        json success_response = {
+            {"success", true},
+            {"message", "Login exitoso"},
+            {"user", {
+                {"id", user->id},
+                {"username", username}
+            }},
+            {"token", server.tokens.issue(user->id, username)},
+            {"refresh_token", server.sessions.create(user->id, username)},
+            {"expires_in", server.tokens.lifetime().count()}
+        };
+        return success_response.dump();
+    }
+    return nlohmann_error("Credenciales inválidas");
+}
+
+std::string login_now(Server& server, const std::string& body) {
+    Credentials credentials;
+    if (server.parser.parse(body, credentials) != CredentialsParser::Status::Ok) {
+        return std::string(api_error(ApiError::LoginFieldsRequired).body());
+    }
+    auto user = server.users.find_by_username(credentials.username);
+    if (user && user->password == credentials.password) {
+        return session_response("Login exitoso", user->id, user->username,
+                                server.tokens.issue(user->id, user->username),
+                                server.sessions.create(user->id, user->username), server.tokens.lifetime());
+    }
+    return std::string(api_error(ApiError::InvalidCredentials).body());
+}
+
+// Alta duplicada: se rechaza en la búsqueda previa, antes de consumir id
+std::string register_duplicate_before(Server& server, const std::string& body) {
+    json request_data = json::parse(body);
+    std::string username = request_data["username"];
+    if (server.users.find_by_username(username)) {
+        return nlohmann_error("El usuario ya existe");
+    }
+    return {};
+}
+
+std::string register_duplicate_now(Server& server, const std::string& body) {
+    Credentials credentials;
+    server.parser.parse(body, credentials);
+    if (server.users.find_by_username(credentials.username)) {
+        return std::string(api_error(ApiError::UserExists).body());
+    }
+    return {};
+}
+
+double ns_per_op(std::size_t iterations, const std::function<std::string()>& op) {
+    Stopwatch sw;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(op().size());
+    }
+    return sw.elapsed_ns() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500'000;
+    const std::size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+
+    for (const ErrorBody& error : kApiErrors) {
+        if (error.body() != nlohmann_error(std::string(error.message()))) {
+            std::printf("❌ cuerpo precalculado distinto de nlohmann: %.*s\n", static_cast<int>(error.body().size()),
+                        error.body().data());
+            return 1;
+        }
+    }
+    const std::pair<TokenVerifier::Status, ApiError> token_errors[] = {
+        {TokenVerifier::Status::Malformed, ApiError::TokenMalformed},
+        {TokenVerifier::Status::BadSignature, ApiError::TokenBadSignature},
+        {TokenVerifier::Status::Expired, ApiError::TokenExpired},
+        {TokenVerifier::Status::Revoked, ApiError::TokenRevoked},
+        {TokenVerifier::Status::UnknownKey, ApiError::TokenUnknownKey},
+    };
+    for (const auto& [status, error] : token_errors) {
+        if (api_error(error).message() != TokenVerifier::describe(status)) {
+            std::printf("❌ %s no coincide con describe()\n", TokenVerifier::describe(status));
+            return 1;
+        }
+    }
+    std::printf("%zu errores precalculados, idénticos a nlohmann\n", std::size(kApiErrors));
+
+    Server server;
+    server.users.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        server.users.insert_if_absent(User{bench_username(i), "secreto", static_cast<int>(i + 1)});
+    }
+    const std::string known = bench_username(count / 2);
+    const std::string good = R"({"username":")" + known + R"(","password":"secreto"})";
+    const std::string wrong = R"({"username":")" + known + R"(","password":"adivinando"})";
+    const std::string unknown = R"({"username":"no_existe","password":"adivinando"})";
+    if (login_before(server, wrong) != login_now(server, wrong) ||
+        login_before(server, unknown) != login_now(server, unknown)) {
+        std::printf("❌ el rechazo de /login cambió de cuerpo\n");
+        return 1;
+    }
+
+    TokenVerifier verifier(server.tokens.keys());
+    const std::string garbage = "eyJhbGciOiJIUzI1NiJ9.basura.firma";
+
+    std::printf("%-28s %12s %12s %14s\n", "caso", "antes ns", "ahora ns", "ahora ops/s");
+    const auto row = [&](const char* name, double before, double now) {
+        std::printf("%-28s %12.1f %12.1f %14.0f\n", name, before, now, 1e9 / now);
+    };
+    row("/login correcto (éxito)", ns_per_op(iterations / 4, [&] { return login_before(server, good); }),
+        ns_per_op(iterations / 4, [&] { return login_now(server, good); }));
+    row("/login password mala (401)", ns_per_op(iterations, [&] { return login_before(server, wrong); }),
+        ns_per_op(iterations, [&] { return login_now(server, wrong); }));
+    row("/login usuario no existe", ns_per_op(iterations, [&] { return login_before(server, unknown); }),
+        ns_per_op(iterations, [&] { return login_now(server, unknown); }));
+    row("/register duplicado (409)", ns_per_op(iterations, [&] { return register_duplicate_before(server, good); }),
+        ns_per_op(iterations, [&] { return register_duplicate_now(server, good); }));
+    row("token basura (401)",
+        ns_per_op(iterations, [&] {
+            return nlohmann_error(TokenVerifier::describe(verifier.verify(garbage).status));
+        }),
+        ns_per_op(iterations, [&] {
+            verifier.verify(garbage);
+            return std::string(api_error(ApiError::TokenMalformed).body());
+        }));
+    return 0;
+}
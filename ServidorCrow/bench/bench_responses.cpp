@@ -0,0 +1,203 @@
+// Cuerpos de respuesta: json{...}.dump() vs JsonWriter (response_bodies).
+// Uso: bench_responses [iteraciones] [usuarios_listado]   (por defecto 1M y 10k)
+//
+// Primero comprueba que cada cuerpo sale idéntico byte a byte al de nlohmann
+// (usernames con comillas, controles, '/', UTF-8...), también los elementos
+// de /verify/batch y los errores con mensaje variable. Después mide ns por respuesta de /login y del listado.
+
+#include "bench_util.h"
+#include "response_bodies.h"
+#include "token_batch.h"
+#include "token_service.h"
+#include "token_verifier.h"
+#include "worker_pool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using nlohmann::json;
+
+// Lo que construían los handlers antes de JsonWriter
+std::string nlohmann_session(const std::string& message, int user_id, const std::string& username,
+                             const std::string& token, const std::string& refresh_token, long long expires_in) {
+    json response = {
+        {"success", true},
+        {"user", {
+            {"id", user_id},
+            {"username", username}
+        }},
+        {"token", token},
+        {"refresh_token", refresh_token},
+        {"expires_in", expires_in}
+    };
+    if (!message.empty()) {
+        response["message"] = message;
+    }
+    return response.dump();
+}
+
+std::string nlohmann_users(const std::vector<std::pair<int, std::string>>& users) {
+    json response = {
+        {"success", true},
+        {"users", json::array()}
+    };
+    for (const auto& [id, username] : users) {
+        response["users"].push_back({
+            {"id", id},
+            {"username", username}
+        });
+    }
+    return response.dump();
+}
+
+std::string nlohmann_error(const std::string& message) {
+    json error_response = {
+        {"success", false},
+        {"error", message}
+    };
+    return error_response.dump();
+}
+
+std::string nlohmann_batch(const TokenVerifier& verifier, const std::vector<std::string_view>& tokens) {
+    json results = json::array();
+    std::size_t valid = 0;
+    for (const auto token : tokens) {
+        const TokenVerifier::Result result = verifier.verify(token);
+        if (result) {
+            results.push_back({
+                {"valid", true},
+                {"user", {
+                    {"id", result.claims->user_id},
+                    {"username", result.claims->username}
+                }},
+                {"exp", result.claims->expires_at}
+            });
+            ++valid;
+        } else {
+            results.push_back({
+                {"valid", false},
+                {"error", TokenVerifier::describe(result.status)}
+            });
+        }
+    }
+    json response = {
+        {"success", true},
+        {"results", results},
+        {"valid", valid}
+    };
+    return response.dump();
+}
+
+bool same(const char* what, const std::string& ours, const std::string& theirs) {
+    if (ours != theirs) {
+        std::printf("❌ %s distinto de nlohmann:\n  %s\n  %s\n", what, ours.c_str(), theirs.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t listed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000;
+
+    const std::string usernames[] = {"juan", "a/b", "com\"illas", "barra\\invertida", "tab\tnl\ncr\r",
+                                     std::string("ctl\x01\x1f\x7f\0", 7), "ñandú", "emoji 🚀", ""};
+    std::vector<std::pair<int, std::string>> users;
+    for (const auto& username : usernames) {
+        for (const char* message : {"Login exitoso", "Usuario registrado exitosamente", ""}) {
+            const int id = static_cast<int>(users.size()) - 3;
+            const std::string ours =
+                session_response(message, id, username, "a.b.c", "r/t", std::chrono::seconds{900});
+            if (!same("session_response", ours, nlohmann_session(message, id, username, "a.b.c", "r/t", 900))) {
+                return 1;
+            }
+        }
+        users.emplace_back(static_cast<int>(users.size()) - 3, username);
+        // Los mensajes variables (p. ej. e.what() al recargar claves) escapan igual
+        if (!same("error_response", error_response(username), nlohmann_error(username))) {
+            return 1;
+        }
+    }
+    if (!same("users_response", users_response(users), nlohmann_users(users)) ||
+        !same("users_response vacío", users_response({}), nlohmann_users({}))) {
+        return 1;
+    }
+
+    // Strings aleatorios: lo que hay que escapar, en cualquier posición de las
+    // palabras de 8 bytes que recorre el escape
+    static const std::string kPieces[] = {"a", "Z", "0", "/", " ", "\"", "\\", "\n", "\t", std::string(1, '\0'),
+                                          "\x1f", "\x7f", "ñ", "🚀"};
+    XorShift64 rng;
+    for (int i = 0; i < 20'000; ++i) {
+        std::string text;
+        const std::size_t pieces = rng.next() % 40;
+        for (std::size_t p = 0; p < pieces; ++p) {
+            text += rng.next() % 4 ? kPieces[rng.next() % 5] : kPieces[rng.next() % std::size(kPieces)];
+        }
+        const std::vector<std::pair<int, std::string>> one = {{i, text}};
+        if (!same("users_response (aleatorio)", users_response(one), nlohmann_users(one))) {
+            return 1;
+        }
+    }
+
+    // /verify/batch: válidos (con usernames raros), expirados, mal firmados y basura
+    TokenService service(std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}});
+    TokenVerifier verifier(service.keys());
+    std::vector<std::string> token_texts;
+    for (std::size_t i = 0; i < 600; ++i) {
+        const std::string& username = usernames[i % std::size(usernames)];
+        switch (i % 4) {
+            case 0: token_texts.push_back(service.issue(static_cast<int>(i), username)); break;
+            case 1: token_texts.push_back(service.issue(static_cast<int>(i), username, 1000, "jti")); break;
+            case 2: token_texts.push_back(service.issue(static_cast<int>(i), username) + "x"); break;
+            case 3: token_texts.push_back("no.es.un.token"); break;
+        }
+    }
+    const std::vector<std::string_view> tokens(token_texts.begin(), token_texts.end());
+    WorkerPool pool(2);
+    if (!same("verify_token_batch", verify_token_batch(verifier, pool, tokens), nlohmann_batch(verifier, tokens))) {
+        return 1;
+    }
+    std::printf("mismos bytes que nlohmann: sesión, listado, lote y errores\n");
+
+    const std::string token = service.issue(123456, "usuario_de_prueba");
+    const std::string refresh_token(32, 'R');
+    Stopwatch sw;
+    for (std::size_t i = 0; i < iterations / 4; ++i) {
+        do_not_optimize(nlohmann_session("Login exitoso", 123456, "usuario_de_prueba", token, refresh_token, 900));
+    }
+    const double dom_ns = sw.elapsed_ns() / (iterations / 4);
+    sw.reset();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        do_not_optimize(session_response("Login exitoso", 123456, "usuario_de_prueba", token, refresh_token,
+                                         std::chrono::seconds{900}));
+    }
+    std::printf("/login: nlohmann %.1f ns, JsonWriter %.1f ns\n", dom_ns, sw.elapsed_ns() / iterations);
+
+    users.clear();
+    for (std::size_t i = 0; i < listed; ++i) {
+        users.emplace_back(static_cast<int>(i), bench_username(i));
+    }
+    const int rounds = 20;
+    sw.reset();
+    for (int r = 0; r < rounds; ++r) {
+        do_not_optimize(nlohmann_users(users));
+    }
+    const double dom_list_ns = sw.elapsed_ns() / rounds / listed;
+    sw.reset();
+    for (int r = 0; r < rounds; ++r) {
+        do_not_optimize(users_response(users));
+    }
+    std::printf("/users (%zu): nlohmann %.1f ns/usuario, JsonWriter %.1f ns/usuario\n", listed, dom_list_ns,
+                sw.elapsed_ns() / rounds / listed);
+    return 0;
+}
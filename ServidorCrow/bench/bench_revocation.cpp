@@ -0,0 +1,162 @@
+// Lista de revocación: memoria por token revocado y latencia de la consulta.
+// Uso: bench_revocation [max_revocados]   (por defecto 1M)
+//
+// La memoria se mide contando los bytes pedidos a operator new (mapa + filtro).
+// Antes de medir comprueba que los lectores nunca usan un filtro ya liberado
+// mientras revoke() lo duplica y sweep() lo reconstruye una y otra vez.
+
+#include "bench_util.h"
+#include "revocation_list.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> g_live_bytes{0};
+// Pone a cero la memoria liberada: un filtro leído tras liberarse dice "no revocado"
+std::atomic<bool> g_scrub{false};
+
+// Con la misma forma que los jti reales (22 caracteres base64url)
+std::string bench_jti(std::uint64_t i) {
+    std::string jti = "jti-" + std::to_string(i);
+    jti.resize(22, '_');
+    return jti;
+}
+
+// Lectores consultando jti revocados mientras otro hilo duplica y reconstruye
+// el filtro sin pausa (como REVOCATION_SWEEP_S=0). Todos deben seguir revocados.
+bool check_reclamation() {
+    const std::int64_t far_future = 4'000'000'000;
+    RevocationList list(64);
+    std::vector<std::string> revoked;
+    for (std::uint64_t i = 0; i < 32; ++i) {
+        revoked.push_back(bench_jti(i));
+        list.revoke(revoked.back(), far_future);
+    }
+
+    g_scrub = true;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> misses{0}, reads{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&, r] {
+            std::uint64_t n = 0;
+            for (std::size_t i = r; !stop.load(std::memory_order_relaxed); ++i, ++n) {
+                if (!list.is_revoked(revoked[i % revoked.size()])) {
+                    misses.fetch_add(1);
+                }
+            }
+            reads.fetch_add(n);
+        });
+    }
+
+    std::uint64_t churn = 1'000'000, publishes = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        // Ya caducados: el barrido los quita y el siguiente lote vuelve a duplicar el filtro
+        for (int i = 0; i < 200; ++i) {
+            list.revoke(bench_jti(churn++), 1);
+        }
+        list.sweep();
+        list.sweep();
+        publishes += 2;
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    g_scrub = false;
+
+    std::printf("reclamación: %llu lecturas, %llu filtros publicados, %llu fallos\n",
+                static_cast<unsigned long long>(reads.load()), static_cast<unsigned long long>(publishes),
+                static_cast<unsigned long long>(misses.load()));
+    return misses.load() == 0;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + 16);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    g_live_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + 16;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        char* block = static_cast<char*>(ptr) - 16;
+        const std::size_t size = *reinterpret_cast<std::size_t*>(block);
+        g_live_bytes.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+        if (g_scrub.load(std::memory_order_relaxed)) {
+            std::memset(ptr, 0, size);
+        }
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t max_revoked = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t checks = 1'000'000;
+    const std::int64_t far_future = 4'000'000'000;
+
+    if (!check_reclamation()) {
+        std::fprintf(stderr, "❌ un lector usó un filtro ya liberado\n");
+        return 1;
+    }
+
+    std::printf("%12s %14s %16s %14s %12s\n", "revocados", "bytes/token", "no revocado ns", "revocado ns",
+                "falsos +");
+
+    for (std::size_t count = 1'000; count <= max_revoked; count *= 10) {
+        // Claves precalculadas para no medir su construcción
+        std::vector<std::string> revoked(count), live(checks);
+        for (std::size_t i = 0; i < count; ++i) {
+            revoked[i] = bench_jti(i);
+        }
+        for (std::size_t i = 0; i < checks; ++i) {
+            live[i] = bench_jti(count + i);
+        }
+
+        const long long before = g_live_bytes.load();
+        RevocationList list(count);
+        for (const auto& jti : revoked) {
+            list.revoke(jti, far_future);
+        }
+        const double bytes = static_cast<double>(g_live_bytes.load() - before) / count;
+
+        Stopwatch sw;
+        std::size_t hits = 0;
+        for (const auto& jti : live) {
+            hits += list.is_revoked(jti);
+        }
+        const double miss_ns = sw.elapsed_ns() / checks;
+
+        XorShift64 rng;
+        sw.reset();
+        for (std::size_t i = 0; i < checks; ++i) {
+            hits += list.is_revoked(revoked[rng.next() % count]);
+        }
+        const double hit_ns = sw.elapsed_ns() / checks;
+        do_not_optimize(hits);
+
+        const RevocationList::Stats s = list.stats();
+        std::printf("%12zu %14.1f %16.1f %14.1f %11.3f%%\n", count, bytes, miss_ns, hit_ns,
+                    100.0 * s.false_positives / checks);
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Sesiones de refresco: memoria por sesión, coste de /refresh y del barrido
+// de caducidad con la rueda de temporizadores frente a recorrer la tabla.
+// Uso: bench_sessions [sesiones]   (por defecto 1M)
+//
+// Las sesiones vencen repartidas de forma uniforme a lo largo de lifetime()
+// (30 días); el barrido simula ese tiempo segundo a segundo. La memoria se
+// mide contando los bytes pedidos a operator new.
+
+#include "bench_util.h"
+#include "coarse_clock.h"
+#include "session_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<long long> g_live_bytes{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    void* block = std::malloc(size + 16);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<std::size_t*>(block) = size;
+    g_live_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    return static_cast<char*>(block) + 16;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        char* block = static_cast<char*>(ptr) - 16;
+        g_live_bytes.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t*>(block)),
+                               std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t refreshes = std::min<std::size_t>(count, 200'000);
+
+    const std::int64_t now = CoarseClock::now_seconds();
+    std::vector<std::int64_t> expires(count);
+    std::vector<std::string> tokens;
+    tokens.reserve(count);
+
+    const long long before = g_live_bytes.load();
+    SessionStore store;
+    const std::int64_t lifetime = store.lifetime().count();
+    XorShift64 rng;
+    for (auto& e : expires) {
+        e = now + 1 + static_cast<std::int64_t>(rng.next() % static_cast<std::uint64_t>(lifetime));
+    }
+
+    Stopwatch sw;
+    for (std::size_t i = 0; i < count; ++i) {
+        tokens.push_back(store.create(static_cast<int>(i + 1), bench_username(i), expires[i]));
+    }
+    const double create_ns = sw.elapsed_ns() / count;
+
+    // Los refresh tokens devueltos (32 caracteres, fuera del SSO) no son del store
+    long long token_bytes = 0;
+    for (const auto& token : tokens) {
+        token_bytes += static_cast<long long>(token.capacity() + 1);
+    }
+    const double store_bytes = static_cast<double>(g_live_bytes.load() - before - token_bytes) / count;
+
+    const SessionStore::Stats created = store.stats();
+    std::printf("%zu sesiones: %.1f bytes/sesión (operator new), %.1f bytes/sesión (tablas + ruedas)\n", count,
+                store_bytes, static_cast<double>(created.memory_bytes) / count);
+    std::printf("create:   %8.1f ns/op\n", create_ns);
+
+    // /refresh: decodificar, buscar, rotar el secreto y reprogramar
+    std::vector<std::size_t> picks(refreshes);
+    for (auto& pick : picks) {
+        pick = rng.next() % count;
+    }
+    sw.reset();
+    std::size_t ok = 0;
+    for (const std::size_t i : picks) {
+        auto renewal = store.refresh(tokens[i]);
+        if (renewal) {
+            tokens[i] = std::move(renewal->refresh_token);
+            ++ok;
+        }
+    }
+    std::printf("refresh:  %8.1f ns/op (%zu/%zu válidos)\n", sw.elapsed_ns() / refreshes, ok, refreshes);
+
+    // Token con el secreto alterado: mismo camino hasta la comparación
+    std::string forged = tokens[0];
+    forged[20] = forged[20] == 'A' ? 'B' : 'A';
+    sw.reset();
+    for (std::size_t i = 0; i < refreshes; ++i) {
+        do_not_optimize(store.refresh(forged).has_value());
+    }
+    std::printf("rechazo:  %8.1f ns/op\n", sw.elapsed_ns() / refreshes);
+
+    // Barrido: el de la rueda, segundo a segundo durante lifetime(), frente a
+    // lo que costaría una sola pasada por todas las expiraciones
+    const std::int64_t end = CoarseClock::now_seconds() + lifetime + 1;
+    sw.reset();
+    std::size_t expired = 0;
+    for (std::int64_t t = now; t <= end; ++t) {
+        expired += store.sweep(t);
+    }
+    const double wheel_s = sw.elapsed_s();
+    const SessionStore::Stats swept = store.stats();
+
+    sw.reset();
+    std::size_t due = 0;
+    for (const std::int64_t e : expires) {
+        due += e <= now + lifetime / 2;
+    }
+    do_not_optimize(due);
+    const double scan_us = sw.elapsed_ns() / 1e3;
+
+    const std::uint64_t sweeps = swept.sweeps - created.sweeps;
+    std::printf("barrido:  %zu caducadas en %lld s simulados, %.2f s en total, %.0f ns/barrido, máx %.2f ms\n",
+                expired, static_cast<long long>(end - now), wheel_s, wheel_s * 1e9 / sweeps,
+                swept.sweep_ns_max / 1e6);
+    std::printf("recorrer la tabla: %.0f us por pasada (%.0f ns/barrido con la rueda)\n", scan_us,
+                wheel_s * 1e9 / sweeps);
+    std::printf("quedan %zu sesiones\n", store.size());
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Verificación de tokens con y sin la caché de TokenVerifier.
+// Uso: bench_token_verify [sesiones] [max_hilos]   (por defecto 100k)
+//
+//   fría:     primera vez que se ve cada token (HMAC + decodificar + JSON)
+//   caliente: el mismo token otra vez (hash + comparación, sin criptografía)
+//   desborde: 4x más sesiones que la capacidad de la caché
+
+#include "bench_util.h"
+#include "token_service.h"
+#include "token_verifier.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Fn>
+double run_threads(unsigned threads, Fn&& fn) {
+    std::vector<std::thread> workers;
+    std::atomic<bool> go{false};
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            fn(t);
+        });
+    }
+    Stopwatch sw;
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    return sw.elapsed_s();
+}
+
+void print_stats(const char* label, const TokenVerifier& verifier) {
+    const TokenVerifier::Stats s = verifier.stats();
+    const double total = static_cast<double>(s.hits + s.misses);
+    std::printf("  %-10s aciertos %5.1f%% | acierto %7.1f ns | verificación %7.1f ns\n", label,
+                total ? 100.0 * s.hits / total : 0.0, s.hits ? double(s.hit_ns_total) / s.hits : 0.0,
+                s.misses ? double(s.verify_ns_total) / s.misses : 0.0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t sessions = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const unsigned max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    TokenService tokens(std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}});
+    std::vector<std::string> issued(sessions);
+    for (std::size_t i = 0; i < sessions; ++i) {
+        issued[i] = tokens.issue(static_cast<int>(i + 1), bench_username(i));
+    }
+
+    std::printf("%zu sesiones\n", sessions);
+    {
+        TokenVerifier verifier(tokens.keys(), sessions * 2);  // holgura: la pasada caliente acierta siempre
+        Stopwatch sw;
+        for (const auto& token : issued) {
+            do_not_optimize(verifier.verify(token).claims);
+        }
+        const double cold = sw.elapsed_ns() / sessions;
+        sw.reset();
+        for (const auto& token : issued) {
+            do_not_optimize(verifier.verify(token).claims);
+        }
+        const double warm = sw.elapsed_ns() / sessions;
+        std::printf("  fría %.1f ns/op, caliente %.1f ns/op\n", cold, warm);
+        print_stats("1 hilo", verifier);
+    }
+    {
+        TokenVerifier verifier(tokens.keys(), std::max<std::size_t>(sessions / 4, 1));
+        XorShift64 rng;
+        for (std::size_t i = 0; i < sessions * 2; ++i) {
+            do_not_optimize(verifier.verify(issued[rng.next() % sessions]).claims);
+        }
+        print_stats("desborde", verifier);
+    }
+
+    std::printf("%8s %18s\n", "hilos", "verificaciones/s");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        TokenVerifier verifier(tokens.keys(), sessions);
+        for (const auto& token : issued) {
+            verifier.verify(token);
+        }
+        const std::size_t per_thread = sessions * 4;
+        const double seconds = run_threads(threads, [&](unsigned t) {
+            XorShift64 rng;
+            rng.state += t;
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                do_not_optimize(verifier.verify(issued[rng.next() % sessions]).claims);
+            }
+        });
+        std::printf("%8u %18.0f\n", threads, per_thread * threads / seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Latencia de búsqueda del MemoryUserStore en función del número de usuarios.
+// Uso: bench_user_store [max_usuarios]   (por defecto 10M)
+
+#include "bench_util.h"
+#include "memory_user_store.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::size_t max_users = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const std::size_t lookups = 1'000'000;
+
+    std::printf("%12s %14s %14s %14s\n", "usuarios", "login ns/op", "id ns/op", "miss ns/op");
+
+    for (std::size_t count = 1'000; count <= max_users; count *= 10) {
+        MemoryUserStore store;
+        store.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            store.insert_if_absent(User{bench_username(i), "secreto", static_cast<int>(i + 1)});
+        }
+
+        // Claves precalculadas para medir solo la búsqueda
+        XorShift64 rng;
+        std::vector<std::string> names(lookups);
+        std::vector<int> ids(lookups);
+        for (std::size_t i = 0; i < lookups; ++i) {
+            std::uint64_t k = rng.next() % count;
+            names[i] = bench_username(k);
+            ids[i] = static_cast<int>(k + 1);
+        }
+
+        Stopwatch sw;
+        for (const auto& name : names) {
+            do_not_optimize(store.lookup(name));
+        }
+        double by_name = sw.elapsed_ns() / lookups;
+
+        sw.reset();
+        for (int id : ids) {
+            do_not_optimize(store.lookup(id));
+        }
+        double by_id = sw.elapsed_ns() / lookups;
+
+        for (auto& name : names) {
+            name[0] = 'x';  // mismo largo, nunca existe
+        }
+        sw.reset();
+        for (const auto& name : names) {
+            do_not_optimize(store.lookup(name));
+        }
+        double miss = sw.elapsed_ns() / lookups;
+
+        std::printf("%12zu %14.1f %14.1f %14.1f\n", count, by_name, by_id, miss);
+    }
+    return 0;
+}
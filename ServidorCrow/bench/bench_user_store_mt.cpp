@@ -0,0 +1,103 @@
+// Estrés concurrente del MemoryUserStore: throughput de registro y login de 1 a N hilos.
+// Uso: bench_user_store_mt [usuarios_por_hilo] [max_hilos]
+// Para verificar ausencia de data races: cmake -DSERVIDOR_SANITIZER=thread
+
+#include "bench_util.h"
+#include "memory_user_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Fn>
+double run_threads(unsigned threads, Fn&& fn) {
+    std::vector<std::thread> workers;
+    std::atomic<bool> go{false};
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            fn(t);
+        });
+    }
+    Stopwatch sw;
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    return sw.elapsed_s();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const unsigned max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t logins_per_thread = per_thread * 4;
+
+    std::printf("%8s %16s %16s %22s\n", "hilos", "registros/s", "logins/s", "logins/s con escrituras");
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        MemoryUserStore store;
+        const std::size_t total = per_thread * threads;
+
+        // Fase 1: registros concurrentes con usernames disjuntos
+        double reg_s = run_threads(threads, [&](unsigned t) {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                std::size_t k = t * per_thread + i;
+                store.insert_if_absent(User{bench_username(k), "secreto", static_cast<int>(k + 1)});
+            }
+        });
+
+        // Fase 2: sólo logins (lecturas)
+        std::atomic<std::size_t> ok{0};
+        double login_s = run_threads(threads, [&](unsigned t) {
+            XorShift64 rng{0x1234567ull + t};
+            std::size_t hits = 0;
+            for (std::size_t i = 0; i < logins_per_thread; ++i) {
+                const User* user = store.lookup(bench_username(rng.next() % total));
+                hits += user != nullptr && user->password == "secreto";
+            }
+            ok.fetch_add(hits, std::memory_order_relaxed);
+        });
+
+        // Fase 3: la mitad de los hilos registra mientras la otra mitad hace login
+        double mixed_rate = 0;
+        if (threads >= 2) {
+            const unsigned readers = threads / 2;
+            std::atomic<std::size_t> done_logins{0};
+            double mixed_s = run_threads(threads, [&](unsigned t) {
+                if (t < readers) {
+                    XorShift64 rng{0xABCDEFull + t};
+                    for (std::size_t i = 0; i < logins_per_thread; ++i) {
+                        do_not_optimize(store.lookup(bench_username(rng.next() % total)));
+                    }
+                    done_logins.fetch_add(logins_per_thread, std::memory_order_relaxed);
+                } else {
+                    for (std::size_t i = 0; i < per_thread; ++i) {
+                        std::size_t k = total + t * per_thread + i;
+                        store.insert_if_absent(User{bench_username(k), "secreto", static_cast<int>(k + 1)});
+                    }
+                }
+            });
+            mixed_rate = done_logins.load() / mixed_s;
+        }
+
+        if (ok.load() != logins_per_thread * threads) {
+            std::fprintf(stderr, "❌ logins fallidos: %zu de %zu\n", logins_per_thread * threads - ok.load(),
+                         logins_per_thread * threads);
+            return 1;
+        }
+
+        std::printf("%8u %16.0f %16.0f %22.0f\n", threads, total / reg_s, logins_per_thread * threads / login_s,
+                    mixed_rate);
+    }
+    return 0;
+}
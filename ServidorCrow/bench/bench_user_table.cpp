@@ -0,0 +1,211 @@
+// Arranque y latencia de /login con la UserTable proyectada (mmap) frente
+// a reconstruir el MemoryUserStore. Antes comprueba que una tabla corrupta
+// se rechaza (al abrir o al buscar) en vez de leer fuera o colgar /login, y
+// que un alta que no cabe en la tabla no llega al log (la reconstrucción con
+// user_table_build fallaría desde entonces).
+// Uso: bench_user_table [usuarios] [ruta]
+
+#include "bench_util.h"
+#include "mapped_user_store.h"
+#include "memory_user_store.h"
+#include "user_table.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Copia de la tabla `path` con `corrupt` aplicado sobre sus bytes; true si
+// abrirla o usarla con `use` lanza
+bool rejects(const std::string& path, const std::function<void(std::string&)>& corrupt,
+             const std::function<void(const UserTable&)>& use) {
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    corrupt(bytes);
+    const std::string copy = path + ".corrupta";
+    std::ofstream(copy, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+    bool thrown = false;
+    try {
+        UserTable table(copy);
+        use(table);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    std::remove(copy.c_str());
+    return thrown;
+}
+
+bool check_corruption(const std::string& path) {
+    std::vector<User> users;
+    for (int i = 0; i < 100; ++i) {
+        users.push_back(User{bench_username(i), "secreto", i + 1});
+    }
+    UserTable::build(path, users, 0);
+    const std::size_t buckets_at = sizeof(UserTableHeader) + users.size() * sizeof(UserTableRecord);
+    auto bucket_count = [&](const std::string& bytes) { return (bytes.size() - buckets_at) / sizeof(UserTableBucket); };
+
+    auto header = [](std::string& bytes) { return reinterpret_cast<UserTableHeader*>(&bytes[0]); };
+    auto bucket = [&](std::string& bytes, std::size_t i) {
+        return reinterpret_cast<UserTableBucket*>(&bytes[buckets_at + i * sizeof(UserTableBucket)]);
+    };
+    auto open_only = [](const UserTable&) {};
+    auto login = [&](const UserTable& t) {
+        for (const User& user : users) {
+            t.find(user.username);
+        }
+        t.find("no_existe");
+    };
+
+    struct Case {
+        const char* name;
+        std::function<void(std::string&)> corrupt;
+        std::function<void(const UserTable&)> use;
+    };
+    const Case cases[] = {
+        {"sin cubos", [&](std::string& b) { header(b)->bucket_count = 0; }, open_only},
+        {"cubos = registros", [&](std::string& b) { header(b)->record_count = header(b)->bucket_count; },
+         open_only},
+        {"cuenta desbordada", [&](std::string& b) { header(b)->record_count = 1ull << 58; }, open_only},
+        {"cubo fuera de rango",
+         [&](std::string& b) {
+             for (std::size_t i = 0; i < bucket_count(b); ++i) {
+                 if (bucket(b, i)->record != 0) {
+                     bucket(b, i)->record = 0xffffffffu;
+                 }
+             }
+         },
+         login},
+        {"índice lleno",
+         [&](std::string& b) {
+             for (std::size_t i = 0; i < bucket_count(b); ++i) {
+                 *bucket(b, i) = UserTableBucket{0, 1};
+             }
+         },
+         login},
+        {"longitud corrupta",
+         [&](std::string& b) {
+             reinterpret_cast<UserTableRecord*>(&b[sizeof(UserTableHeader)])->password_len = 255;
+         },
+         [](const UserTable& t) { UserTable::to_user(t.record(0)); }},
+    };
+    for (const Case& c : cases) {
+        if (!rejects(path, c.corrupt, c.use)) {
+            std::fprintf(stderr, "❌ tabla corrupta aceptada: %s\n", c.name);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_long_credentials(const std::string& path) {
+    const std::string log_path = path + ".log";
+    std::remove(log_path.c_str());
+    UserTable::build(path, {User{"juan", "1234", 1}}, 0);
+
+    const std::string long_name(UserTableRecord::kUsernameSlot + 1, 'u');
+    const std::string long_password(UserTableRecord::kPasswordSlot + 1, 'p');
+    {
+        MappedUserStore store(path, log_path, 1);
+        if (store.accepts(long_name, "1234") || store.accepts("ana", long_password) || !store.accepts("ana", "1234")) {
+            std::fprintf(stderr, "❌ accepts() no sigue los huecos de la tabla\n");
+            return false;
+        }
+        bool thrown = false;
+        try {
+            store.insert_batch({User{"ana", "1234", 2}, User{long_name, "1234", 3}});
+        } catch (const std::length_error&) {
+            thrown = true;
+        }
+        if (!thrown || store.find_by_username("ana") || !store.insert_if_absent(User{"ana", "1234", 2})) {
+            std::fprintf(stderr, "❌ un alta que no cabe en la tabla se aceptó o bloqueó el resto\n");
+            return false;
+        }
+    }
+
+    // Lo que haría user_table_build: tabla + log a una tabla nueva
+    std::vector<User> users;
+    {
+        MappedUserStore store(path, log_path, 1);
+        store.for_each([&](const User& user) { users.push_back(user); });
+    }
+    bool fits = users.size() == 2;
+    for (const User& user : users) {
+        fits = fits && UserTable::fits(user);
+    }
+    std::remove(log_path.c_str());
+    if (!fits) {
+        std::fprintf(stderr, "❌ el log tiene %zu usuarios o alguno no cabe en la tabla\n", users.size());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const std::string path = argc > 2 ? argv[2] : "bench_users.table";
+    const std::size_t lookups = 1'000'000;
+
+    if (!check_corruption(path) || !check_long_credentials(path)) {
+        return 1;
+    }
+
+    std::vector<User> users;
+    users.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        users.push_back(User{bench_username(i), "secreto", static_cast<int>(i + 1)});
+    }
+
+    Stopwatch sw;
+    UserTable::build(path, users, 0);
+    std::printf("construir tabla:    %8.2f s\n", sw.elapsed_s());
+
+    XorShift64 rng;
+    std::vector<std::string> names(lookups);
+    for (auto& name : names) {
+        name = bench_username(rng.next() % count);
+    }
+
+    // Arranque: abrir la tabla frente a cargar el índice en memoria
+    sw.reset();
+    UserTable table(path);
+    std::printf("abrir (mmap):       %8.3f ms\n", sw.elapsed_ns() / 1e6);
+
+    sw.reset();
+    MemoryUserStore store;
+    store.reserve(count);
+    store.bulk_load(users, 1);
+    std::printf("cargar en memoria:  %8.3f ms\n", sw.elapsed_ns() / 1e6);
+
+    // Primera pasada: incluye fallos de página; segunda: páginas ya residentes
+    for (const char* pass : {"mmap (frío)", "mmap (caliente)"}) {
+        sw.reset();
+        std::size_t found = 0;
+        for (const auto& name : names) {
+            const UserTableRecord* record = table.find(name);
+            found += record != nullptr && record->password_len == 7;
+        }
+        std::printf("login %-16s %8.1f ns/op\n", pass, sw.elapsed_ns() / lookups);
+        if (found != lookups) {
+            std::fprintf(stderr, "❌ encontrados %zu de %zu\n", found, lookups);
+            return 1;
+        }
+    }
+
+    sw.reset();
+    for (const auto& name : names) {
+        do_not_optimize(store.lookup(name));
+    }
+    std::printf("login memoria:          %8.1f ns/op\n", sw.elapsed_ns() / lookups);
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,264 @@
+// GET /users?limit=&cursor=: coste de una página según su posición.
+// Uso: bench_users_page [usuarios] [limit]   (por defecto 10M y 100)
+//
+// Comprueba antes el IdIndex contra un std::set (huecos, varios segmentos),
+// que recorrer por cursor da todos los usuarios en orden con cualquier
+// limit, con cuerpos idénticos a los de nlohmann, y que las altas
+// concurrentes no repiten ni saltan a los que ya existían. Después mide la
+// página por cursor a distintas profundidades frente a un OFFSET que ordena
+// todo el motor (lo que costaría paginar sin índice ordenado).
+
+#include "bench_util.h"
+#include "compact_user_store.h"
+#include "id_index.h"
+#include "memory_user_store.h"
+#include "user_page.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using nlohmann::json;
+
+// La página como la escribiría nlohmann, para comparar bytes
+std::string nlohmann_page(const UserStore& store, int after_id, std::size_t limit) {
+    std::vector<User> users = store.page(after_id, limit + 1);
+    json response = {
+        {"success", true},
+        {"users", json::array()}
+    };
+    if (users.size() > limit) {
+        users.pop_back();
+        response["next_cursor"] = encode_user_cursor(users.back().id);
+    }
+    for (const User& user : users) {
+        response["users"].push_back({
+            {"id", user.id},
+            {"username", user.username}
+        });
+    }
+    return response.dump();
+}
+
+// Recorre el motor página a página como un cliente; ids en el orden recibido
+bool walk(const UserStore& store, std::size_t limit, std::vector<int>& ids, bool compare_bytes) {
+    int after_id = 0;
+    while (true) {
+        const std::string body = user_page_response(store, after_id, limit);
+        if (compare_bytes && body != nlohmann_page(store, after_id, limit)) {
+            std::printf("❌ página distinta de nlohmann:\n  %s\n", body.c_str());
+            return false;
+        }
+        const json page = json::parse(body);
+        for (const auto& user : page["users"]) {
+            ids.push_back(user["id"].get<int>());
+        }
+        if (!page.contains("next_cursor")) {
+            return true;
+        }
+        if (!decode_user_cursor(page["next_cursor"].get<std::string>(), after_id)) {
+            std::printf("❌ next_cursor no se puede decodificar\n");
+            return false;
+        }
+    }
+}
+
+bool check_index() {
+    IdIndex index;
+    std::set<int> reference;
+    XorShift64 rng;
+    // Rachas densas, huecos grandes y ids sueltos en segmentos lejanos
+    for (int i = 0; i < 200'000; ++i) {
+        const int id = rng.next() % 8 ? static_cast<int>(rng.next() % 3'000'000)
+                                      : static_cast<int>(rng.next() % 2'147'483'647u);
+        index.insert(id);
+        reference.insert(id);
+    }
+    for (int id = 5'000'000; id < 5'010'000; ++id) {
+        index.insert(id);
+        reference.insert(id);
+    }
+    index.insert(2'147'483'647);
+    reference.insert(2'147'483'647);
+    index.insert(-7);  // se ignora
+    for (int i = 0; i < 200'000; ++i) {
+        const int after = i < 100 ? i - 50 : static_cast<int>(rng.next() % 2'147'483'647u);
+        const auto it = reference.upper_bound(after);
+        const int expected = it == reference.end() ? IdIndex::kNone : *it;
+        if (index.next(after) != expected) {
+            std::printf("❌ IdIndex::next(%d) = %d, esperado %d\n", after, index.next(after), expected);
+            return false;
+        }
+    }
+    int count = 0;
+    for (int id = index.next(-1); id != IdIndex::kNone; id = index.next(id)) {
+        ++count;
+    }
+    if (count != static_cast<int>(reference.size()) || index.next(2'147'483'647) != IdIndex::kNone) {
+        std::printf("❌ IdIndex recorrió %d ids de %zu\n", count, reference.size());
+        return false;
+    }
+    return true;
+}
+
+bool check_cursor() {
+    for (const int id : {0, 1, 100, 65'535, 1 << 20, 2'147'483'647}) {
+        int decoded = -1;
+        if (!decode_user_cursor(encode_user_cursor(id), decoded) || decoded != id) {
+            std::printf("❌ el cursor de %d no vuelve\n", id);
+            return false;
+        }
+    }
+    const std::string good = encode_user_cursor(100);
+    int ignored;
+    for (const std::string& bad : {std::string(), good.substr(1), good + "A", std::string("AgAAAGQh"),
+                                  std::string("AQAAAGQ="), std::string("AQAAAGQi"), encode_user_cursor(-5)}) {
+        if (decode_user_cursor(bad, ignored)) {
+            std::printf("❌ cursor inválido aceptado: %s\n", bad.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool check_walks() {
+    MemoryUserStore memory;
+    CompactUserStore compact;
+    std::vector<int> expected;
+    int id = 0;
+    for (int i = 0; i < 5'000; ++i) {
+        id += i % 97 == 0 ? 64 * (1 + i % 5) : 1;  // bloques de ids que nadie usó
+        const User user{(i % 3 ? "usuario/" : "com\"illas ñ ") + std::to_string(i), "secreto", id};
+        memory.insert_if_absent(user);
+        compact.insert_if_absent(user);
+        expected.push_back(id);
+    }
+    for (const UserStore* store : {static_cast<const UserStore*>(&memory), static_cast<const UserStore*>(&compact)}) {
+        for (const std::size_t limit : {std::size_t{1}, std::size_t{7}, std::size_t{100}, std::size_t{5'000},
+                                        std::size_t{10'000}}) {
+            std::vector<int> ids;
+            if (!walk(*store, limit, ids, limit >= 100) || ids != expected) {
+                std::printf("❌ %s con limit %zu: %zu usuarios de %zu\n", store->name(), limit, ids.size(),
+                            expected.size());
+                return false;
+            }
+        }
+    }
+    MemoryUserStore empty;
+    std::vector<int> none;
+    return walk(empty, 10, none, true) && none.empty();
+}
+
+// Recorrido con /register concurrentes (ids de otro rango, como otro bloque)
+bool check_concurrent() {
+    MemoryUserStore store;
+    const int existing = 50'000;
+    for (int i = 1; i <= existing; ++i) {
+        store.insert_if_absent(User{bench_username(i), "secreto", i});
+    }
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; !done.load(); ++i) {
+            const int id = i % 2 ? existing + 1 + i : 1'000'000 + i;
+            store.insert_if_absent(User{"nuevo" + std::to_string(i), "secreto", id});
+        }
+    });
+    std::vector<int> ids;
+    const bool walked = walk(store, 100, ids, false);
+    done = true;
+    writer.join();
+    if (!walked || !std::is_sorted(ids.begin(), ids.end()) ||
+        std::adjacent_find(ids.begin(), ids.end()) != ids.end()) {
+        std::printf("❌ páginas desordenadas o repetidas con altas concurrentes\n");
+        return false;
+    }
+    for (int i = 1; i <= existing; ++i) {
+        if (!std::binary_search(ids.begin(), ids.end(), i)) {
+            std::printf("❌ el usuario %d se perdió con altas concurrentes\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Paginación por OFFSET sin índice ordenado: ordenar hasta la posición pedida
+std::vector<User> offset_page(const MemoryUserStore& store, std::size_t offset, std::size_t limit) {
+    std::vector<const User*> all;
+    store.for_each_shard([&](const std::vector<const User*>& records) {
+        all.insert(all.end(), records.begin(), records.end());
+    });
+    const auto by_id = [](const User* a, const User* b) { return a->id < b->id; };
+    const std::size_t first = std::min(offset, all.size());
+    const std::size_t last = std::min(offset + limit, all.size());
+    std::nth_element(all.begin(), all.begin() + first, all.end(), by_id);
+    std::partial_sort(all.begin() + first, all.begin() + last, all.end(), by_id);
+    std::vector<User> result;
+    for (std::size_t i = first; i < last; ++i) {
+        result.push_back(*all[i]);
+    }
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    const std::size_t limit = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+
+    if (!check_index() || !check_cursor() || !check_walks() || !check_concurrent()) {
+        return 1;
+    }
+    std::printf("IdIndex = std::set; recorrido por cursor completo y ordenado (también con altas concurrentes)\n");
+
+    // Ids como los deja el IdAllocator tras varios arranques: huecos de bloque
+    std::vector<User> users;
+    users.reserve(count);
+    int id = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        id += i % 1000 == 999 ? 40 : 1;
+        users.push_back(User{bench_username(i), "secreto", id});
+    }
+    std::vector<int> ids;
+    ids.reserve(count);
+    for (const User& user : users) {
+        ids.push_back(user.id);
+    }
+    MemoryUserStore store;
+    store.reserve(count);
+    Stopwatch sw;
+    store.bulk_load(users, std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("%zu usuarios cargados en %.1f s\n", count, sw.elapsed_s());
+
+    std::printf("%-12s %16s %16s\n", "posición", "cursor µs", "OFFSET ms");
+    for (const double depth : {0.0, 0.1, 0.5, 0.9, 0.9999}) {
+        const auto position = static_cast<std::size_t>(depth * static_cast<double>(count));
+        const int after_id = position == 0 ? 0 : ids[position - 1];
+        const int rounds = 2'000;
+        sw.reset();
+        for (int r = 0; r < rounds; ++r) {
+            do_not_optimize(user_page_response(store, after_id, limit));
+        }
+        const double cursor_us = sw.elapsed_ns() / rounds / 1e3;
+
+        sw.reset();
+        const std::vector<User> offset = offset_page(store, position, limit);
+        const double offset_ms = sw.elapsed_ns() / 1e6;
+        const std::vector<User> keyset = store.page(after_id, limit);
+        if (offset.size() != keyset.size() || (!offset.empty() && offset.front().id != keyset.front().id)) {
+            std::printf("❌ OFFSET y cursor no dan la misma página en %zu\n", position);
+            return 1;
+        }
+        std::printf("%-12zu %16.1f %16.1f\n", position, cursor_us, offset_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// GET /users servido por Crow de verdad: el listado del spool llega entero y su
+// fichero sigue en disco hasta que Crow termina de enviarlo.
+// Uso: bench_users_send [usuarios] [puerto]   (por defecto 200k, 18091)
+//
+// /users no es un stream de Crow sino un fichero (set_static_file_info) que la
+// Entry borra al salir del handler. Eso sólo es correcto mientras Crow envíe el
+// fichero dentro de res.end() (Connection::do_write_static, síncrono en CrowCpp
+// 1.x); si una versión nueva lo difiere al io_context, el fichero desaparece
+// antes de leerse y este programa falla. El listado ocupa varios MiB para que
+// no quepa en los buffers del socket: el cliente lee el primer trozo, comprueba
+// que el fichero sigue ahí y después lee el resto.
+
+#include "bench_util.h"
+#include "memory_user_store.h"
+#include "user_list_stream.h"
+
+#include <crow.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::string streamed(const UserStore& store) {
+    UserListStream stream(store);
+    std::string body;
+    for (auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) {
+        body += chunk;
+    }
+    return body;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    const auto port = static_cast<std::uint16_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 18091);
+
+    MemoryUserStore store;
+    store.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        store.insert_if_absent(User{bench_username(i), "secreto", static_cast<int>(i + 1)});
+    }
+    const std::string expected = streamed(store);
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "bench-users-send";
+    UserListSpool spool(directory.string(), 4, std::uint64_t{1} << 40);
+    const auto spool_files = [&] {
+        return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+    };
+
+    // El mismo handler que main.cpp, sin la paginación
+    crow::SimpleApp app;
+    app.loglevel(crow::LogLevel::Warning);
+    CROW_ROUTE(app, "/users")
+    ([&](const crow::request&, crow::response& res) {
+        UserListSpool::Entry listing = spool.write(store);
+        if (listing) {
+            res.set_static_file_info(listing.path());
+        } else {
+            res.code = 503;
+        }
+        res.end();
+    });
+    auto server = app.port(port).concurrency(2).run_async();
+    app.wait_for_server_start();
+
+    const auto fail = [&](const char* message) {
+        std::printf("❌ %s\n", message);
+        app.stop();
+        server.wait();
+        return 1;
+    };
+
+    asio::io_context io;
+    asio::ip::tcp::socket socket(io);
+    Stopwatch sw;
+    socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+    const std::string request = "GET /users HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+    asio::write(socket, asio::buffer(request));
+
+    std::string response;
+    char buffer[16 * 1024];
+    asio::error_code error;
+    response.append(buffer, socket.read_some(asio::buffer(buffer), error));
+    // Con varios MiB por delante el servidor sigue bloqueado en el envío
+    if (!error && expected.size() > 4 * 1024 * 1024 && spool_files() != 1) {
+        return fail("el fichero del listado se borró antes de terminar el envío");
+    }
+    while (!error) {
+        response.append(buffer, socket.read_some(asio::buffer(buffer), error));
+    }
+    const double elapsed = sw.elapsed_s();
+    if (error != asio::error::eof) {
+        return fail("la conexión se cortó antes del final del listado");
+    }
+
+    const std::size_t body_at = response.find("\r\n\r\n");
+    if (response.compare(0, 12, "HTTP/1.1 200") != 0 || body_at == std::string::npos ||
+        response.compare(body_at + 4, std::string::npos, expected) != 0) {
+        return fail("el cuerpo recibido no es el listado completo");
+    }
+    // La Entry se destruye al volver del handler, ya con la respuesta enviada
+    for (int i = 0; i < 100 && spool_files() != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (spool_files() != 0) {
+        return fail("el listado enviado no borró su fichero");
+    }
+
+    std::printf("%zu usuarios: %.1f MiB recibidos enteros en %.1f ms; fichero vivo durante el envío\n", count,
+                static_cast<double>(expected.size()) / (1024 * 1024), elapsed * 1e3);
+    app.stop();
+    server.wait();
+    return 0;
+}
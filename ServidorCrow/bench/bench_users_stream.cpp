@@ -0,0 +1,246 @@
+// GET /users: listado entero en memoria vs UserListStream volcado por trozos.
+// Uso: bench_users_stream [usuarios]   (por defecto 1M)
+//
+// Comprueba primero que los trozos concatenados (y el fichero del spool) son
+// los bytes de users_response(), con varios tamaños de página, en el motor en
+// memoria y el compacto, que el spool respeta sus cupos y no deja ficheros, y
+// que un recorrido con /register concurrentes no repite ni desordena ids. Después mide tiempo y pico de RSS (VmHWM, que se
+// reinicia entre casos con /proc/self/clear_refs) de cada forma de responder.
+
+#include "bench_util.h"
+#include "compact_user_store.h"
+#include "memory_user_store.h"
+#include "response_bodies.h"
+#include "user_list_stream.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+
+using nlohmann::json;
+
+// Lo que hacía /users: todos los pares en un vector, ordenados, y un string
+std::string listed_in_memory(const UserStore& store) {
+    std::vector<std::pair<int, std::string>> users;
+    store.for_each([&](const User& user) { users.emplace_back(user.id, user.username); });
+    std::sort(users.begin(), users.end());
+    return users_response(users);
+}
+
+// Y antes de JsonWriter, un DOM de nlohmann con un objeto por usuario
+std::string listed_dom(const UserStore& store) {
+    std::vector<std::pair<int, std::string>> users;
+    store.for_each([&](const User& user) { users.emplace_back(user.id, user.username); });
+    std::sort(users.begin(), users.end());
+    json response = {
+        {"success", true},
+        {"users", json::array()}
+    };
+    for (const auto& [id, username] : users) {
+        response["users"].push_back({
+            {"id", id},
+            {"username", username}
+        });
+    }
+    return response.dump();
+}
+
+std::string streamed(const UserStore& store, std::size_t page_size) {
+    UserListStream stream(store, page_size);
+    std::string body;
+    for (auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) {
+        body += chunk;
+    }
+    return body;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// KiB de /proc/self/status ("VmHWM" o "VmRSS"); 0 fuera de Linux
+std::size_t status_kib(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, std::char_traits<char>::length(field), field) == 0) {
+            return std::strtoull(line.c_str() + line.find(':') + 1, nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+// Devuelve al sistema lo liberado por el caso anterior y pone VmHWM en el RSS actual
+void reset_peak_rss() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+bool same_listing(const char* what, const UserStore& store) {
+    const std::string expected = listed_in_memory(store);
+    for (const std::size_t page_size : {std::size_t{1}, std::size_t{7}, UserListStream::kDefaultPageSize}) {
+        if (streamed(store, page_size) != expected) {
+            std::printf("❌ %s: el stream (página %zu) no coincide con users_response\n", what, page_size);
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    // Equivalencia: usernames con escapes, huecos en los ids y motor vacío
+    const std::string usernames[] = {"juan", "a/b", "com\"illas", "barra\\invertida", "tab\tnl\ncr\r",
+                                     std::string("ctl\x01\x1f\0", 6), "ñandú", "emoji 🚀"};
+    MemoryUserStore memory;
+    CompactUserStore compact;
+    if (!same_listing("memoria vacía", memory) || !same_listing("compacto vacío", compact)) {
+        return 1;
+    }
+    for (int i = 0; i < 3000; ++i) {
+        if (i % 11 == 3) {
+            continue;  // id consumido por un alta que falló
+        }
+        const User user{usernames[i % std::size(usernames)] + std::to_string(i), "secreto", i + 1};
+        memory.insert_if_absent(user);
+        compact.insert_if_absent(user);
+    }
+    if (!same_listing("memoria", memory) || !same_listing("compacto", compact)) {
+        return 1;
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "bench-users-spool";
+    const auto spool_files = [&] {
+        return std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator());
+    };
+    {
+        // Resto de un proceso anterior: se borra al crear el spool
+        std::filesystem::create_directories(directory);
+        std::ofstream(directory / "users-AbC123.json") << "[]";
+        UserListSpool spool(directory.string(), 1, 1 << 30);
+        if (spool_files() != 0) {
+            std::printf("❌ el spool no limpió los listados de un proceso anterior\n");
+            return 1;
+        }
+
+        std::string path;
+        {
+            const UserListSpool::Entry entry = spool.write(memory);
+            path = entry.path();
+            if (!entry || read_file(path) != listed_in_memory(memory)) {
+                std::printf("❌ el fichero del spool no coincide con users_response\n");
+                return 1;
+            }
+            if (spool.write(memory)) {
+                std::printf("❌ el spool superó su máximo de listados a la vez\n");
+                return 1;
+            }
+        }
+        if (std::filesystem::exists(path) || !spool.write(memory)) {
+            std::printf("❌ el listado enviado no liberó su fichero ni su cupo\n");
+            return 1;
+        }
+
+        UserListSpool small(directory.string(), 4, 1024);
+        const UserListSpool::Entry refused = small.write(memory);
+        if (refused || !refused.too_large() || spool_files() != 0) {
+            std::printf("❌ el spool superó su máximo de bytes o dejó el fichero a medias\n");
+            return 1;
+        }
+
+        // Cabe solo pero no junto al que ya está en curso: ocupado, no demasiado grande
+        const std::uint64_t listing_bytes = listed_in_memory(memory).size();
+        UserListSpool shared(directory.string(), 4, listing_bytes + listing_bytes / 2);
+        const UserListSpool::Entry first = shared.write(memory);
+        const UserListSpool::Entry second = shared.write(memory);
+        if (!first || second || second.too_large()) {
+            std::printf("❌ el spool confundió un listado en espera con uno demasiado grande\n");
+            return 1;
+        }
+    }
+
+    // Altas concurrentes durante el recorrido: ids estrictamente crecientes
+    {
+        MemoryUserStore store;
+        for (int i = 1; i <= 20'000; ++i) {
+            store.insert_if_absent(User{bench_username(i), "secreto", i});
+        }
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (int i = 20'001; !done.load(); ++i) {
+                store.insert_if_absent(User{bench_username(i), "secreto", i});
+            }
+        });
+        const std::string body = streamed(store, 64);
+        done = true;
+        writer.join();
+        long long previous = 0;
+        std::size_t listed = 0;
+        for (std::size_t at = body.find(R"("id":)"); at != std::string::npos; at = body.find(R"("id":)", at + 1)) {
+            const long long id = std::strtoll(body.c_str() + at + 5, nullptr, 10);
+            if (id <= previous) {
+                std::printf("❌ id %lld tras %lld con altas concurrentes\n", id, previous);
+                return 1;
+            }
+            previous = id;
+            ++listed;
+        }
+        if (listed < 20'000 || body.compare(body.size() - 2, 2, "]}") != 0) {
+            std::printf("❌ listado concurrente incompleto (%zu usuarios)\n", listed);
+            return 1;
+        }
+    }
+    std::printf("stream idéntico a users_response (memoria, compacto, spool); altas concurrentes en orden\n");
+
+    MemoryUserStore store;
+    store.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        store.insert_if_absent(User{bench_username(i), "secreto", static_cast<int>(i + 1)});
+    }
+    UserListSpool spool(directory.string(), 1, std::uint64_t{1} << 40);
+
+    std::printf("%zu usuarios (RSS con el motor cargado: %zu MiB)\n", count, status_kib("VmRSS:") / 1024);
+    std::printf("%-34s %10s %16s\n", "forma", "ms", "pico RSS +MiB");
+    const auto row = [&](const char* name, const std::function<std::size_t()>& list) {
+        reset_peak_rss();
+        const std::size_t before = status_kib("VmRSS:");
+        Stopwatch sw;
+        const std::size_t bytes = list();
+        const double ms = sw.elapsed_ns() / 1e6;
+        const std::size_t peak = status_kib("VmHWM:");
+        std::printf("%-34s %10.1f %16.1f   (%zu MiB de cuerpo)\n", name, ms,
+                    peak > before ? (peak - before) / 1024.0 : 0.0, bytes >> 20);
+    };
+    row("UserListStream a fichero (spool)", [&] {
+        const UserListSpool::Entry written = spool.write(store);
+        return static_cast<std::size_t>(std::filesystem::file_size(written.path()));
+    });
+    row("vector ordenado + users_response", [&] { return listed_in_memory(store).size(); });
+    row("DOM nlohmann + dump()", [&] { return listed_dom(store).size(); });
+    std::filesystem::remove(directory);
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Utilidades mínimas compartidas por los benchmarks (sin dependencias externas)
+
+class Stopwatch {
+public:
+    Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+    void reset() { m_start = std::chrono::steady_clock::now(); }
+
+    double elapsed_ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    double elapsed_s() const { return elapsed_ns() / 1e9; }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// Generador pseudoaleatorio barato para elegir claves sin sesgar la medición
+struct XorShift64 {
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    std::uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+inline std::string bench_username(std::uint64_t i) {
+    return "user" + std::to_string(i);
+}
+
+// Evita que el compilador elimine resultados no usados
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
@@ -0,0 +1,82 @@
+// Verificación por lotes (POST /verify/batch): latencia de un lote según los
+// hilos del WorkerPool, con la caché fría (primer lote) y caliente (repetido).
+// Uso: bench_verify_batch [tokens_por_lote] [max_hilos]   (por defecto 10k)
+//
+// La latencia incluye serializar la respuesta. El parse del body es la parte
+// de un solo hilo: se compara el escáner de token_batch con nlohmann.
+
+#include "bench_util.h"
+#include "token_batch.h"
+#include "token_service.h"
+#include "worker_pool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    const std::size_t batch = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000;
+    const unsigned max_threads = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const int rounds = 20;
+
+    TokenService service(std::vector<KeyRing::Spec>{{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}});
+    nlohmann::json body = {{"tokens", nlohmann::json::array()}};
+    for (std::size_t i = 0; i < batch; ++i) {
+        body["tokens"].push_back(service.issue(static_cast<int>(i + 1), bench_username(i)));
+    }
+    const std::string text = body.dump();
+
+    Stopwatch sw;
+    for (int r = 0; r < rounds; ++r) {
+        do_not_optimize(nlohmann::json::parse(text));
+    }
+    const double dom_ms = sw.elapsed_ns() / rounds / 1e6;
+
+    std::vector<std::string_view> tokens;
+    sw.reset();
+    for (int r = 0; r < rounds; ++r) {
+        if (!parse_token_batch(text, tokens)) {
+            std::printf("❌ el escáner no acepta el body\n");
+            return 1;
+        }
+    }
+    const double scan_ms = sw.elapsed_ns() / rounds / 1e6;
+    const nlohmann::json request = nlohmann::json::parse(text);
+    for (std::size_t i = 0; i < batch; ++i) {
+        if (tokens[i] != request["tokens"][i].get_ref<const std::string&>()) {
+            std::printf("❌ el escáner y nlohmann no leen lo mismo\n");
+            return 1;
+        }
+    }
+    std::printf("lote de %zu tokens (%zu KiB): parse del body %.2f ms con nlohmann, %.2f ms con el escáner\n",
+                batch, text.size() / 1024, dom_ms, scan_ms);
+
+    std::printf("%8s %12s %16s %12s %16s\n", "hilos", "fría ms", "fría tokens/s", "caliente ms", "caliente tokens/s");
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        WorkerPool pool(threads);
+        TokenVerifier verifier(service.keys(), batch * 2);
+
+        sw.reset();
+        const std::string response = verify_token_batch(verifier, pool, tokens);
+        const double cold = sw.elapsed_s();
+        if (nlohmann::json::parse(response)["valid"] != batch) {
+            std::printf("❌ tokens rechazados en el lote\n");
+            return 1;
+        }
+
+        sw.reset();
+        for (int r = 0; r < rounds; ++r) {
+            do_not_optimize(verify_token_batch(verifier, pool, tokens).size());
+        }
+        const double warm = sw.elapsed_s() / rounds;
+        std::printf("%8u %12.2f %16.0f %12.2f %16.0f\n", threads, cold * 1e3, batch / cold, warm * 1e3,
+                    batch / warm);
+    }
+    return 0;
+}
@@ -0,0 +1,378 @@
+#include "base64url.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BASE64URL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Valor de cada carácter del alfabeto; 64 = inválido
+struct DecodeTable {
+    unsigned char value[256];
+
+    constexpr DecodeTable() : value() {
+        for (unsigned char& v : value) {
+            v = 64;
+        }
+        for (unsigned i = 0; i < 64; ++i) {
+            value[static_cast<unsigned char>(kAlphabet[i])] = static_cast<unsigned char>(i);
+        }
+    }
+};
+
+constexpr DecodeTable kDecode;
+
+// Un núcleo procesa los bloques completos que puede desde el principio y
+// devuelve los bytes (encode) o caracteres (decode) de entrada que consumió;
+// el resto lo termina la versión escalar. Decode devuelve kInvalid si algún
+// carácter no es del alfabeto.
+using EncodeKernel = std::size_t (*)(const unsigned char* in, std::size_t size, char* out);
+using DecodeKernel = std::size_t (*)(const unsigned char* in, std::size_t size, char* out);
+
+constexpr std::size_t kInvalid = SIZE_MAX;
+
+std::size_t encode_none(const unsigned char*, std::size_t, char*) {
+    return 0;
+}
+
+std::size_t decode_none(const unsigned char*, std::size_t, char*) {
+    return 0;
+}
+
+std::size_t encode_first(const unsigned char* in, std::size_t size, char* out);
+std::size_t decode_first(const unsigned char* in, std::size_t size, char* out);
+
+#ifdef BASE64URL_X86
+
+// Algoritmos de W. Muła y D. Lemire ("Faster Base64 Encoding and Decoding
+// using AVX2 Instructions"), con el alfabeto url ('-' y '_' en lugar de '+' y '/').
+
+// 12 bytes (en los 16 del registro) -> 16 índices de 6 bits
+__attribute__((target("ssse3"))) inline __m128i encode_indices(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+// Índice -> carácter: se suma un desplazamiento por rango (A-Z, a-z, 0-9, -, _)
+__attribute__((target("ssse3"))) inline __m128i encode_chars(__m128i indices) {
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, range), indices);
+}
+
+__attribute__((target("avx2"))) inline __m256i encode_indices(__m256i in) {
+    const __m128i order = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(order));
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+__attribute__((target("avx2"))) inline __m256i encode_chars(__m256i indices) {
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(shift), range), indices);
+}
+
+// Se leen 16 bytes para usar 12: el bucle para antes de salirse de la entrada
+__attribute__((target("ssse3"))) std::size_t encode_ssse3(const unsigned char* in, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 12, out += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encode_chars(encode_indices(block)));
+    }
+    return i;
+}
+
+// Cada mitad del registro lleva 12 bytes (leídos de 16 en 16, como en SSSE3)
+__attribute__((target("avx2"))) std::size_t encode_avx2(const unsigned char* in, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; i + 28 <= size; i += 24, out += 32) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+        const __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), encode_chars(encode_indices(block)));
+    }
+    // GCC no lo emite aquí solo, y sin él el código SSE que sigue (la cola
+    // SSSE3, memcpy) paga la transición AVX -> SSE en cada llamada
+    _mm256_zeroupper();
+    return i + encode_ssse3(in + i, size - i, out);
+}
+
+// Carácter -> valor de 6 bits por rangos; `valid` marca los bytes del alfabeto.
+// Los bytes >= 0x80 son negativos con signo y no caen en ningún rango.
+__attribute__((target("ssse3"))) inline __m128i decode_values(__m128i c, __m128i& valid) {
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), c));
+    const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), c));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    const __m128i dash = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+    const __m128i underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+    valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, dash), underscore));
+
+    __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(static_cast<char>(-'A')));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(static_cast<char>(26 - 'a'))));
+    shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    shift = _mm_or_si128(shift, _mm_and_si128(dash, _mm_set1_epi8(62 - '-')));
+    shift = _mm_or_si128(shift, _mm_and_si128(underscore, _mm_set1_epi8(63 - '_')));
+    return _mm_add_epi8(c, shift);
+}
+
+// 16 valores de 6 bits -> 12 bytes en las posiciones 0..11
+__attribute__((target("ssse3"))) inline __m128i decode_pack(__m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(words, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("avx2"))) inline __m256i decode_values(__m256i c, __m256i& valid) {
+    const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+    const __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i dash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-'));
+    const __m256i underscore = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_'));
+    valid = _mm256_or_si256(_mm256_or_si256(upper, lower),
+                            _mm256_or_si256(_mm256_or_si256(digit, dash), underscore));
+
+    __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(static_cast<char>(-'A')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(static_cast<char>(26 - 'a'))));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(dash, _mm256_set1_epi8(62 - '-')));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(underscore, _mm256_set1_epi8(63 - '_')));
+    return _mm256_add_epi8(c, shift);
+}
+
+__attribute__((target("avx2"))) inline __m256i decode_pack(__m256i values) {
+    const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m128i order = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i packed = _mm256_shuffle_epi8(words, _mm256_broadcastsi128_si256(order));
+    // 12 bytes por mitad -> 24 seguidos al principio
+    return _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+
+// Se escriben exactamente 12 bytes por bloque: out sólo tiene sitio para lo decodificado
+__attribute__((target("ssse3"))) std::size_t decode_ssse3(const unsigned char* in, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16, out += 12) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i valid;
+        const __m128i values = decode_values(block, valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            return kInvalid;
+        }
+        const __m128i bytes = decode_pack(values);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+        const std::uint32_t last = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8)));
+        std::memcpy(out + 8, &last, 4);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) std::size_t decode_avx2(const unsigned char* in, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32, out += 24) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i valid;
+        const __m256i values = decode_values(block, valid);
+        if (_mm256_movemask_epi8(valid) != -1) {
+            return kInvalid;
+        }
+        const __m256i bytes = decode_pack(values);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(bytes, 1));
+    }
+    const std::size_t rest = decode_ssse3(in + i, size - i, out);
+    return rest == kInvalid ? kInvalid : i + rest;
+}
+
+#endif  // BASE64URL_X86
+
+struct Kernels {
+    EncodeKernel encode;
+    DecodeKernel decode;
+};
+
+bool supported(Base64Kernel kernel) {
+#ifdef BASE64URL_X86
+    __builtin_cpu_init();  // por si se llama desde un constructor estático
+    switch (kernel) {
+        case Base64Kernel::Scalar: return true;
+        case Base64Kernel::Ssse3: return __builtin_cpu_supports("ssse3");
+        case Base64Kernel::Avx2: return __builtin_cpu_supports("avx2");
+    }
+    return false;
+#else
+    return kernel == Base64Kernel::Scalar;
+#endif
+}
+
+Kernels kernels_for(Base64Kernel kernel) {
+#ifdef BASE64URL_X86
+    switch (kernel) {
+        case Base64Kernel::Scalar: break;
+        case Base64Kernel::Ssse3: return {encode_ssse3, decode_ssse3};
+        case Base64Kernel::Avx2: return {encode_avx2, decode_avx2};
+    }
+#endif
+    (void)kernel;
+    return {encode_none, decode_none};
+}
+
+Base64Kernel best_kernel() {
+    if (supported(Base64Kernel::Avx2)) {
+        return Base64Kernel::Avx2;
+    }
+    return supported(Base64Kernel::Ssse3) ? Base64Kernel::Ssse3 : Base64Kernel::Scalar;
+}
+
+// Inicialización constante: la primera llamada (aunque sea desde el
+// constructor estático de otra unidad) elige el núcleo y se sustituye a sí
+// misma. Después sólo lo cambia base64url_set_kernel (benchmarks).
+std::atomic<EncodeKernel> g_encode{encode_first};
+std::atomic<DecodeKernel> g_decode{decode_first};
+std::atomic<int> g_kernel{-1};
+
+void resolve() {
+    if (g_kernel.load(std::memory_order_relaxed) < 0) {
+        base64url_set_kernel(best_kernel());
+    }
+}
+
+std::size_t encode_first(const unsigned char* in, std::size_t size, char* out) {
+    resolve();
+    return g_encode.load(std::memory_order_relaxed)(in, size, out);
+}
+
+std::size_t decode_first(const unsigned char* in, std::size_t size, char* out) {
+    resolve();
+    return g_decode.load(std::memory_order_relaxed)(in, size, out);
+}
+
+}  // namespace
+
+void base64url_encode(const void* data, std::size_t size, std::string& out) {
+    const std::size_t start = out.size();
+    out.resize(start + base64url_encoded_size(size));
+    base64url_encode(data, size, &out[start]);
+}
+
+char* base64url_encode(const void* data, std::size_t size, char* dst) {
+    const auto* in = static_cast<const unsigned char*>(data);
+
+    // Bloques de 3 bytes -> 4 caracteres: lo que consume el núcleo es múltiplo de 12
+    std::size_t i = g_encode.load(std::memory_order_relaxed)(in, size, dst);
+    dst += i / 3 * 4;
+    for (; i + 3 <= size; i += 3) {
+        const unsigned v = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        *dst++ = kAlphabet[v >> 18];
+        *dst++ = kAlphabet[(v >> 12) & 63];
+        *dst++ = kAlphabet[(v >> 6) & 63];
+        *dst++ = kAlphabet[v & 63];
+    }
+    if (size - i == 1) {
+        const unsigned v = in[i] << 16;
+        *dst++ = kAlphabet[v >> 18];
+        *dst++ = kAlphabet[(v >> 12) & 63];
+    } else if (size - i == 2) {
+        const unsigned v = (in[i] << 16) | (in[i + 1] << 8);
+        *dst++ = kAlphabet[v >> 18];
+        *dst++ = kAlphabet[(v >> 12) & 63];
+        *dst++ = kAlphabet[(v >> 6) & 63];
+    }
+    return dst;
+}
+
+bool base64url_decode(std::string_view text, std::string& out) {
+    const std::size_t tail = text.size() % 4;
+    if (tail == 1) {
+        return false;
+    }
+    const std::size_t start = out.size();
+    out.resize(start + text.size() / 4 * 3 + (tail ? tail - 1 : 0));
+    char* dst = &out[start];
+    const auto* in = reinterpret_cast<const unsigned char*>(text.data());
+
+    std::size_t i = g_decode.load(std::memory_order_relaxed)(in, text.size(), dst);
+    if (i == kInvalid) {
+        return false;
+    }
+    dst += i / 4 * 3;
+    for (; i + 4 <= text.size(); i += 4) {
+        const unsigned a = kDecode.value[in[i]], b = kDecode.value[in[i + 1]];
+        const unsigned c = kDecode.value[in[i + 2]], d = kDecode.value[in[i + 3]];
+        if ((a | b | c | d) & 64) {
+            return false;
+        }
+        const unsigned v = (a << 18) | (b << 12) | (c << 6) | d;
+        *dst++ = static_cast<char>(v >> 16);
+        *dst++ = static_cast<char>(v >> 8);
+        *dst++ = static_cast<char>(v);
+    }
+    if (tail) {
+        const unsigned a = kDecode.value[in[i]], b = kDecode.value[in[i + 1]];
+        const unsigned c = tail == 3 ? kDecode.value[in[i + 2]] : 0;
+        if ((a | b | c) & 64) {
+            return false;
+        }
+        // Bits que no llegan a un byte: a cero, o dos textos darían los mismos bytes
+        if ((tail == 2 ? b & 15 : c & 3) != 0) {
+            return false;
+        }
+        const unsigned v = (a << 18) | (b << 12) | (c << 6);
+        *dst++ = static_cast<char>(v >> 16);
+        if (tail == 3) {
+            *dst++ = static_cast<char>(v >> 8);
+        }
+    }
+    return true;
+}
+
+Base64Kernel base64url_kernel() {
+    resolve();
+    return static_cast<Base64Kernel>(g_kernel.load(std::memory_order_relaxed));
+}
+
+bool base64url_set_kernel(Base64Kernel kernel) {
+    if (!supported(kernel)) {
+        return false;
+    }
+    const Kernels k = kernels_for(kernel);
+    g_encode.store(k.encode, std::memory_order_relaxed);
+    g_decode.store(k.decode, std::memory_order_relaxed);
+    g_kernel.store(static_cast<int>(kernel), std::memory_order_relaxed);
+    return true;
+}
+
+const char* base64url_kernel_name(Base64Kernel kernel) {
+    switch (kernel) {
+        case Base64Kernel::Scalar: return "scalar";
+        case Base64Kernel::Ssse3: return "ssse3";
+        case Base64Kernel::Avx2: return "avx2";
+    }
+    return "?";
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Base64url sin relleno (RFC 4648 §5), el alfabeto de las partes de un JWT.
+//
+// En x86 los bloques completos se codifican/decodifican con SSSE3 (12 bytes
+// <-> 16 caracteres) o AVX2 (24 <-> 32), elegido al arrancar según la CPU; el
+// resto y las demás plataformas usan la versión escalar. Todas dan los mismos
+// bytes y aceptan/rechazan las mismas entradas.
+
+// Largo de la codificación de size bytes
+constexpr std::size_t base64url_encoded_size(std::size_t size) {
+    return (size * 4 + 2) / 3;
+}
+
+// Añade la codificación de [data, data + size) al final de out
+void base64url_encode(const void* data, std::size_t size, std::string& out);
+
+// Escribe la codificación en out (base64url_encoded_size(size) bytes) y
+// devuelve el puntero al final
+char* base64url_encode(const void* data, std::size_t size, char* out);
+
+// Añade la decodificación de text al final de out. Devuelve false (sin
+// garantías sobre out) si text no es base64url canónico sin relleno: los bits
+// sobrantes del último carácter deben ser cero.
+bool base64url_decode(std::string_view text, std::string& out);
+
+enum class Base64Kernel { Scalar, Ssse3, Avx2 };
+
+// Núcleo en uso (por defecto, el mejor que soporta la CPU)
+Base64Kernel base64url_kernel();
+
+// Cambia el núcleo para todos los hilos (benchmarks y pruebas de
+// equivalencia); false, sin cambiar nada, si la CPU no lo soporta
+bool base64url_set_kernel(Base64Kernel kernel);
+
+const char* base64url_kernel_name(Base64Kernel kernel);
@@ -0,0 +1,17 @@
+#include "claims_response.h"
+
+#include "json_writer.h"
+
+std::string claims_response(const TokenClaims& claims) {
+    // Partes fijas, los dos números y el username (con margen para escapes)
+    JsonWriter out(96 + claims.username.size());
+    out.begin_object()
+        .key("exp").value(claims.expires_at)
+        .key("success").value(true)
+        .key("user").begin_object()
+            .key("id").value(claims.user_id)
+            .key("username").value(claims.username)
+        .end_object()
+    .end_object();
+    return out.take();
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "token_verifier.h"
+
+#include <string>
+
+// Cuerpo de GET /me y GET /verify, escrito directamente desde los claims
+// del token, sin tocar el motor de usuarios ni construir un nlohmann::json:
+//
+//   {"exp":N,"success":true,"user":{"id":1,"username":"juan"}}
+//
+// Se escribe con JsonWriter en un string reservado una vez; el resultado es
+// idéntico byte a byte a dump() de nlohmann. El username viene de un payload
+// ya validado por nlohmann, así que es UTF-8 válido.
+std::string claims_response(const TokenClaims& claims);
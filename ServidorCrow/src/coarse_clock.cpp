@@ -0,0 +1,18 @@
+#include "coarse_clock.h"
+
+#include <chrono>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+std::int64_t CoarseClock::now_seconds() {
+#if defined(CLOCK_REALTIME_COARSE)
+    timespec ts;
+    if (clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+        return static_cast<std::int64_t>(ts.tv_sec);
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
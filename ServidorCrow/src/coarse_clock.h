@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// Reloj de pared con resolución de tick del kernel (unos pocos ms).
+//
+// Basta para el exp de los tokens (segundos) y en Linux es una lectura de la
+// página vDSO sin calibrar el TSC (CLOCK_REALTIME_COARSE). En otras
+// plataformas recurre a std::chrono::system_clock.
+struct CoarseClock {
+    // Segundos desde la época Unix
+    static std::int64_t now_seconds();
+};
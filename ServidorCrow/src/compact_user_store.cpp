@@ -0,0 +1,210 @@
+#include "compact_user_store.h"
+
+#include "user_table.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+std::optional<User> CompactUserStore::find_by_username(std::string_view username) const {
+    const Shard& shard = m_shards[shard_index(UserTable::hash(username))];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const std::int64_t row = shard.find_row(username);
+    return row < 0 ? std::nullopt : std::optional<User>(shard.user_at(static_cast<std::size_t>(row)));
+}
+
+std::optional<User> CompactUserStore::find_by_id(int id) const {
+    return id < 0 ? std::nullopt : user_by_id(id);
+}
+
+bool CompactUserStore::insert_if_absent(const User& user) {
+    if (user.username.size() > 0xFFFF || user.password.size() > 0xFFFF || user.id < 0) {
+        throw std::length_error("CompactUserStore: usuario fuera de rango");
+    }
+
+    const std::uint64_t hash = UserTable::hash(user.username);
+    const std::size_t index = shard_index(hash);
+    std::uint32_t row = 0;
+    {
+        Shard& shard = m_shards[index];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.find_row(user.username) >= 0) {
+            return false;
+        }
+        if (shard.arena.size() + user.username.size() + user.password.size() > 0xFFFFFFFFu) {
+            throw std::length_error("CompactUserStore: arena del shard lleno (4 GiB)");
+        }
+        if (shard.ids.size() + 1 >= (std::size_t{1} << kRowBits)) {
+            throw std::length_error("CompactUserStore: shard lleno");
+        }
+
+        row = static_cast<std::uint32_t>(shard.ids.size());
+        shard.ids.push_back(user.id);
+        shard.credentials.push_back(Credentials{static_cast<std::uint32_t>(shard.arena.size()),
+                                                static_cast<std::uint16_t>(user.username.size()),
+                                                static_cast<std::uint16_t>(user.password.size())});
+        shard.arena.insert(shard.arena.end(), user.username.begin(), user.username.end());
+        shard.arena.insert(shard.arena.end(), user.password.begin(), user.password.end());
+
+        if (shard.ids.size() * 2 > shard.buckets.size()) {
+            shard.grow_index(std::max<std::size_t>(16, shard.buckets.size() * 2));  // incluye la fila nueva
+        } else {
+            shard.insert_bucket(hash, row);
+        }
+    }
+
+    // Visible por username antes que por id, como en MemoryUserStore
+    {
+        IdShard& id_shard = m_id_shards[static_cast<std::size_t>(user.id) % kShardCount];
+        const std::size_t slot = static_cast<std::size_t>(user.id) / kShardCount;
+        std::unique_lock<std::shared_mutex> lock(id_shard.mutex);
+        if (slot >= id_shard.rows.size()) {
+            id_shard.rows.resize(std::max<std::size_t>(slot + 1, id_shard.rows.size() * 2), kNoRow);
+        }
+        id_shard.rows[slot] = static_cast<std::uint32_t>(index) << kRowBits | row;
+    }
+    m_ids.insert(user.id);
+    int max = m_max_id.load(std::memory_order_relaxed);
+    while (user.id > max && !m_max_id.compare_exchange_weak(max, user.id, std::memory_order_release)) {
+    }
+    return true;
+}
+
+std::vector<User> CompactUserStore::page(int after_id, std::size_t limit) const {
+    std::vector<User> result;
+    result.reserve(std::min<std::size_t>(limit, 4096));
+    for (int id = m_ids.next(after_id); id != IdIndex::kNone && result.size() < limit; id = m_ids.next(id)) {
+        if (auto user = user_by_id(id)) {
+            result.push_back(std::move(*user));
+        }
+    }
+    return result;
+}
+
+void CompactUserStore::for_each(const std::function<void(const User&)>& fn) const {
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        for (std::size_t row = 0; row < shard.ids.size(); ++row) {
+            fn(shard.user_at(row));
+        }
+    }
+}
+
+std::size_t CompactUserStore::size() const {
+    std::size_t total = 0;
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.ids.size();
+    }
+    return total;
+}
+
+int CompactUserStore::max_id() const {
+    return m_max_id.load(std::memory_order_acquire);
+}
+
+void CompactUserStore::reserve(std::size_t count, std::size_t text_bytes) {
+    // Holgura para el reparto desigual entre shards
+    const std::size_t per_shard = count / kShardCount + count / (kShardCount * 8) + 16;
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.ids.reserve(per_shard);
+        shard.credentials.reserve(per_shard);
+        shard.arena.reserve(text_bytes / kShardCount + text_bytes / (kShardCount * 8));
+        std::size_t buckets = 16;
+        while (buckets < per_shard * 2) {
+            buckets <<= 1;
+        }
+        if (buckets > shard.buckets.size()) {
+            shard.grow_index(buckets);
+        }
+    }
+    for (IdShard& shard : m_id_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.rows.reserve(count / kShardCount + 1);
+    }
+}
+
+std::size_t CompactUserStore::memory_bytes() const {
+    std::size_t total = m_ids.memory_bytes();
+    for (const Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.ids.capacity() * sizeof(std::int32_t) + shard.credentials.capacity() * sizeof(Credentials) +
+                 shard.arena.capacity() + shard.buckets.capacity() * sizeof(Bucket);
+    }
+    for (const IdShard& shard : m_id_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.rows.capacity() * sizeof(std::uint32_t);
+    }
+    return total;
+}
+
+std::optional<User> CompactUserStore::user_by_id(int id) const {
+    std::uint32_t ref = kNoRow;
+    {
+        const IdShard& id_shard = m_id_shards[static_cast<std::size_t>(id) % kShardCount];
+        const std::size_t slot = static_cast<std::size_t>(id) / kShardCount;
+        std::shared_lock<std::shared_mutex> lock(id_shard.mutex);
+        if (slot < id_shard.rows.size()) {
+            ref = id_shard.rows[slot];
+        }
+    }
+    if (ref == kNoRow) {
+        return std::nullopt;
+    }
+    const Shard& shard = m_shards[ref >> kRowBits];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.user_at(ref & ((std::uint32_t{1} << kRowBits) - 1));
+}
+
+// Bits 32..37 del hash: los cubos usan los bajos, así que dentro de un shard
+// siguen repartiéndose por toda la tabla
+std::size_t CompactUserStore::shard_index(std::uint64_t hash) {
+    return static_cast<std::size_t>(hash >> 32) % kShardCount;
+}
+
+std::int64_t CompactUserStore::Shard::find_row(std::string_view username) const {
+    if (buckets.empty()) {
+        return -1;
+    }
+    const std::uint64_t h = UserTable::hash(username);
+    const auto tag = static_cast<std::uint32_t>(h >> 32);
+    const std::size_t mask = buckets.size() - 1;
+
+    for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+        const Bucket& bucket = buckets[i];
+        if (bucket.row == 0) {
+            return -1;
+        }
+        if (bucket.tag == tag && username_at(bucket.row - 1) == username) {
+            return bucket.row - 1;
+        }
+    }
+}
+
+std::string_view CompactUserStore::Shard::username_at(std::size_t row) const {
+    const Credentials& c = credentials[row];
+    return {arena.data() + c.offset, c.username_len};
+}
+
+User CompactUserStore::Shard::user_at(std::size_t row) const {
+    const Credentials& c = credentials[row];
+    const char* text = arena.data() + c.offset;
+    return User{std::string(text, c.username_len), std::string(text + c.username_len, c.password_len), ids[row]};
+}
+
+void CompactUserStore::Shard::insert_bucket(std::uint64_t hash, std::uint32_t row) {
+    const std::size_t mask = buckets.size() - 1;
+    std::size_t i = hash & mask;
+    while (buckets[i].row != 0) {
+        i = (i + 1) & mask;
+    }
+    buckets[i] = Bucket{static_cast<std::uint32_t>(hash >> 32), row + 1};
+}
+
+void CompactUserStore::Shard::grow_index(std::size_t count) {
+    buckets.assign(count, Bucket{0, 0});
+    for (std::size_t row = 0; row < ids.size(); ++row) {
+        insert_bucket(UserTable::hash(username_at(row)), static_cast<std::uint32_t>(row));
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "id_index.h"
+#include "user_store.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+// Motor en memoria compacto, en columnas (struct-of-arrays).
+//
+// En lugar de un User con dos std::string por usuario, guarda:
+//   - ids:          int32 por fila
+//   - credenciales: referencia (offset/largos) al arena, por fila
+//   - arena:        usernames y passwords contiguos en un único buffer
+//   - índice hash:  cubos {etiqueta, fila} de direccionamiento abierto
+//   - índice id:    tabla directa id -> fila (los ids son casi densos)
+// Sin asignaciones por usuario, unos 30-60 bytes por usuario más el texto, y un
+// /login toca un cubo, una fila y el texto en el arena.
+//
+// Como MemoryUserStore, todo va en shards por hash del username, cada uno con
+// sus columnas y su shared_mutex, y el índice por id en shards aparte (por id).
+// Un alta que redimensiona vectores o rehace el índice hash sólo copia su
+// shard y sólo frena los /login de ese shard. page() salta de id en id con un
+// IdIndex, sin recorrer la tabla id -> fila.
+class CompactUserStore : public UserStore {
+public:
+    static constexpr std::size_t kShardCount = 64;
+
+    const char* name() const override { return "compact"; }
+
+    std::optional<User> find_by_username(std::string_view username) const override;
+    std::optional<User> find_by_id(int id) const override;
+    bool insert_if_absent(const User& user) override;
+    std::vector<User> page(int after_id, std::size_t limit) const override;
+    void for_each(const std::function<void(const User&)>& fn) const override;
+    std::size_t size() const override;
+    int max_id() const override;
+
+    // Dimensiona de antemano columnas, arena e índices para `count` usuarios
+    void reserve(std::size_t count, std::size_t text_bytes);
+
+    // Bytes reservados por todas las estructuras (para el benchmark de memoria)
+    std::size_t memory_bytes() const;
+
+private:
+    struct Credentials {
+        std::uint32_t offset;        // inicio del username en el arena
+        std::uint16_t username_len;  // el password va justo detrás
+        std::uint16_t password_len;
+    };
+
+    struct Bucket {
+        std::uint32_t tag;  // 32 bits altos del hash
+        std::uint32_t row;  // fila + 1; 0 = vacío
+    };
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::vector<std::int32_t> ids;
+        std::vector<Credentials> credentials;
+        std::vector<char> arena;
+        std::vector<Bucket> buckets;
+
+        std::int64_t find_row(std::string_view username) const;
+        std::string_view username_at(std::size_t row) const;
+        User user_at(std::size_t row) const;
+        void insert_bucket(std::uint64_t hash, std::uint32_t row);
+        void grow_index(std::size_t buckets);
+    };
+
+    // Fila de cada id de su shard (id / kShardCount), como shard << 26 | fila
+    struct alignas(64) IdShard {
+        mutable std::shared_mutex mutex;
+        std::vector<std::uint32_t> rows;
+    };
+
+    static constexpr std::uint32_t kNoRow = 0xFFFFFFFFu;
+    static constexpr unsigned kRowBits = 26;
+
+    static std::size_t shard_index(std::uint64_t hash);
+    std::optional<User> user_by_id(int id) const;
+
+    std::array<Shard, kShardCount> m_shards;
+    std::array<IdShard, kShardCount> m_id_shards;
+    IdIndex m_ids;
+    std::atomic<int> m_max_id{0};
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3, el mismo que zlib) con slicing-by-8: ~8 bytes por
+// iteración, suficiente para que verificar registros no limite la lectura.
+std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0);
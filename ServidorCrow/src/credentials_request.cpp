@@ -0,0 +1,429 @@
+#include "credentials_request.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void append_utf8(std::string& out, std::uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Lector con la gramática de nlohmann (RFC 8259 estricto, sin comentarios)
+class Reader {
+public:
+    Reader(std::string_view text, std::string& nesting) : m_text(text), m_nesting(nesting) {}
+
+    bool bom() {
+        if (m_pos < m_text.size() && static_cast<unsigned char>(m_text[0]) == 0xEF) {
+            if (m_text.substr(0, 3) != "\xEF\xBB\xBF") {
+                return false;
+            }
+            m_pos = 3;
+        }
+        return true;
+    }
+
+    bool eat(char c) {
+        skip_spaces();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool peek(char c) {
+        skip_spaces();
+        return m_pos < m_text.size() && m_text[m_pos] == c;
+    }
+
+    bool at_end() {
+        skip_spaces();
+        return m_pos == m_text.size();
+    }
+
+    // String JSON (posición en la comilla de apertura). Sin escapes, `out` es
+    // una vista sobre el texto; con escapes se decodifica al final de
+    // `decoded` (si es nullptr sólo se valida y `out` no se toca).
+    bool string(std::string* decoded, std::string_view& out) {
+        if (!eat('"')) {
+            return false;
+        }
+        const std::size_t begin = m_pos;
+        for (;;) {
+            m_pos = plain_run(m_pos);
+            if (m_pos == m_text.size()) {
+                return false;
+            }
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                out = m_text.substr(begin, m_pos++ - begin);
+                return true;
+            }
+            if (c == '\\') {
+                break;
+            }
+            if (c < 0x20 || !utf8()) {
+                return false;
+            }
+        }
+
+        const std::size_t start = decoded ? decoded->size() : 0;
+        std::size_t run = begin;
+        for (;;) {
+            if (decoded) {
+                decoded->append(m_text.data() + run, m_pos - run);
+            }
+            if (m_pos == m_text.size()) {
+                return false;
+            }
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                ++m_pos;
+                if (decoded) {
+                    out = std::string_view(decoded->data() + start, decoded->size() - start);
+                }
+                return true;
+            }
+            if (c == '\\') {
+                if (!escape(decoded)) {
+                    return false;
+                }
+            } else if (c < 0x20) {
+                return false;
+            } else {
+                // UTF-8 válido: se copia con el siguiente tramo
+                run = m_pos;
+                if (!utf8()) {
+                    return false;
+                }
+                m_pos = plain_run(m_pos);
+                continue;
+            }
+            run = m_pos;
+            m_pos = plain_run(m_pos);
+        }
+    }
+
+    // Cualquier valor JSON, sin recursión (nlohmann tampoco limita la profundidad)
+    bool skip_value() {
+        m_nesting.clear();
+        for (;;) {
+            skip_spaces();
+            if (m_pos == m_text.size()) {
+                return false;
+            }
+            const char c = m_text[m_pos];
+            if (c == '{' || c == '[') {
+                ++m_pos;
+                const char close = c == '{' ? '}' : ']';
+                if (!eat(close)) {
+                    m_nesting += close;
+                    if (close == '}' && !member_key()) {
+                        return false;
+                    }
+                    continue;
+                }
+            } else if (c == '"') {
+                std::string_view ignored;
+                if (!string(nullptr, ignored)) {
+                    return false;
+                }
+            } else if (c == '-' || (c >= '0' && c <= '9')) {
+                if (!number()) {
+                    return false;
+                }
+            } else if (!literal("true") && !literal("false") && !literal("null")) {
+                return false;
+            }
+
+            // Tras un valor: cerrar contenedores o pasar al siguiente elemento
+            for (;;) {
+                if (m_nesting.empty()) {
+                    return true;
+                }
+                if (eat(',')) {
+                    if (m_nesting.back() == '}' && !member_key()) {
+                        return false;
+                    }
+                    break;
+                }
+                if (!eat(m_nesting.back())) {
+                    return false;
+                }
+                m_nesting.pop_back();
+            }
+        }
+    }
+
+private:
+    // Fin del tramo de ASCII imprimible sin comillas ni escapes que empieza en
+    // `pos` (índice local: el bucle no toca m_pos en memoria en cada byte)
+    std::size_t plain_run(std::size_t pos) const {
+        const std::size_t size = m_text.size();
+        while (pos < size) {
+            const auto c = static_cast<unsigned char>(m_text[pos]);
+            if (c == '"' || c == '\\' || c < 0x20 || c >= 0x80) {
+                break;
+            }
+            ++pos;
+        }
+        return pos;
+    }
+
+    // Secuencia de escape (posición en la barra); la decodifica en `decoded`
+    bool escape(std::string* decoded) {
+        if (++m_pos == m_text.size()) {
+            return false;
+        }
+        char plain;
+        switch (m_text[m_pos++]) {
+            case '"': plain = '"'; break;
+            case '\\': plain = '\\'; break;
+            case '/': plain = '/'; break;
+            case 'b': plain = '\b'; break;
+            case 'f': plain = '\f'; break;
+            case 'n': plain = '\n'; break;
+            case 'r': plain = '\r'; break;
+            case 't': plain = '\t'; break;
+            case 'u': {
+                std::uint32_t cp;
+                if (!unicode_escape(cp)) {
+                    return false;
+                }
+                if (decoded) {
+                    append_utf8(*decoded, cp);
+                }
+                return true;
+            }
+            default: return false;
+        }
+        if (decoded) {
+            *decoded += plain;
+        }
+        return true;
+    }
+
+    void skip_spaces() {
+        while (m_pos < m_text.size() &&
+               (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+            ++m_pos;
+        }
+    }
+
+    unsigned byte_at(std::size_t offset) const {
+        return m_pos + offset < m_text.size() ? static_cast<unsigned char>(m_text[m_pos + offset]) : 0;
+    }
+
+    // Secuencia UTF-8 bien formada (RFC 3629: sin overlongs, surrogates ni > U+10FFFF)
+    bool utf8() {
+        const unsigned lead = byte_at(0);
+        std::size_t size;
+        unsigned low = 0x80, high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            size = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            size = 3;
+            low = lead == 0xE0 ? 0xA0 : low;
+            high = lead == 0xED ? 0x9F : high;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            size = 4;
+            low = lead == 0xF0 ? 0x90 : low;
+            high = lead == 0xF4 ? 0x8F : high;
+        } else {
+            return false;
+        }
+        if (byte_at(1) < low || byte_at(1) > high) {
+            return false;
+        }
+        for (std::size_t i = 2; i < size; ++i) {
+            if (byte_at(i) < 0x80 || byte_at(i) > 0xBF) {
+                return false;
+            }
+        }
+        m_pos += size;
+        return true;
+    }
+
+    bool hex4(std::uint32_t& value) {
+        if (m_text.size() - m_pos < 4) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int digit = hex_value(m_text[m_pos++]);
+            if (digit < 0) {
+                return false;
+            }
+            value = value << 4 | static_cast<std::uint32_t>(digit);
+        }
+        return true;
+    }
+
+    // \uXXXX (ya leído "\u"); un surrogate alto exige el bajo a continuación
+    bool unicode_escape(std::uint32_t& cp) {
+        if (!hex4(cp) || (cp >= 0xDC00 && cp <= 0xDFFF)) {
+            return false;
+        }
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            std::uint32_t low;
+            if (m_text.substr(m_pos, 2) != "\\u") {
+                return false;
+            }
+            m_pos += 2;
+            if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                return false;
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        return true;
+    }
+
+    bool digits() {
+        const std::size_t begin = m_pos;
+        while (m_pos < m_text.size() && m_text[m_pos] >= '0' && m_text[m_pos] <= '9') {
+            ++m_pos;
+        }
+        return m_pos != begin;
+    }
+
+    bool number() {
+        const std::size_t begin = m_pos;
+        if (m_text[m_pos] == '-') {
+            ++m_pos;
+        }
+        if (m_pos < m_text.size() && m_text[m_pos] == '0') {
+            ++m_pos;
+        } else if (!digits()) {
+            return false;
+        }
+        if (m_pos < m_text.size() && m_text[m_pos] == '.') {
+            ++m_pos;
+            if (!digits()) {
+                return false;
+            }
+        }
+        bool exponent = false;
+        if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+            exponent = true;
+            if (++m_pos < m_text.size() && (m_text[m_pos] == '+' || m_text[m_pos] == '-')) {
+                ++m_pos;
+            }
+            if (!digits()) {
+                return false;
+            }
+        }
+        // nlohmann rechaza los números que no caben en un double (1e999, o un
+        // entero de más de 308 cifras); sólo pueden serlo con exponente o muy largos
+        if (exponent || m_pos - begin > 300) {
+            const std::string token(m_text.substr(begin, m_pos - begin));
+            return std::isfinite(std::strtod(token.c_str(), nullptr));
+        }
+        return true;
+    }
+
+    bool literal(std::string_view word) {
+        if (m_text.substr(m_pos, word.size()) != word) {
+            return false;
+        }
+        m_pos += word.size();
+        return true;
+    }
+
+    bool member_key() {
+        std::string_view ignored;
+        return string(nullptr, ignored) && eat(':');
+    }
+
+    std::string_view m_text;
+    std::size_t m_pos = 0;
+    std::string& m_nesting;
+};
+
+enum class Field { Absent, String, Other };
+
+}  // namespace
+
+CredentialsParser::Status CredentialsParser::parse(std::string_view body, Credentials& out) {
+    // El lexer de nlohmann toma un byte 0 como fin de la entrada (dentro de un
+    // string sería un control, inválido igualmente): se corta ahí
+    body = body.substr(0, body.find('\0'));
+
+    // Lo decodificado nunca ocupa más que el texto: reservar aquí evita que
+    // una segunda decodificación mueva el buffer e invalide la primera vista
+    m_unescaped.clear();
+    m_unescaped.reserve(body.size());
+    Reader reader(body, m_nesting);
+    if (!reader.bom()) {
+        return Status::Malformed;
+    }
+
+    // Otro valor que no sea un objeto: válido, pero sin campos
+    if (!reader.peek('{')) {
+        return reader.skip_value() && reader.at_end() ? Status::Missing : Status::Malformed;
+    }
+    reader.eat('{');
+
+    Field username = Field::Absent, password = Field::Absent;
+    if (!reader.eat('}')) {
+        do {
+            m_key.clear();
+            std::string_view key;
+            if (!reader.string(&m_key, key) || !reader.eat(':')) {
+                return Status::Malformed;
+            }
+            Field* field = key == "username" ? &username : key == "password" ? &password : nullptr;
+            std::string_view& target = field == &username ? out.username : out.password;
+            if (field && reader.peek('"')) {
+                if (!reader.string(&m_unescaped, target)) {
+                    return Status::Malformed;
+                }
+                *field = Field::String;
+            } else if (!reader.skip_value()) {
+                return Status::Malformed;
+            } else if (field) {
+                *field = Field::Other;
+            }
+        } while (reader.eat(','));
+        if (!reader.eat('}')) {
+            return Status::Malformed;
+        }
+    }
+    if (!reader.at_end()) {
+        return Status::Malformed;
+    }
+
+    if (username == Field::Absent || password == Field::Absent) {
+        return Status::Missing;
+    }
+    return username == Field::String && password == Field::String ? Status::Ok : Status::NotString;
+}
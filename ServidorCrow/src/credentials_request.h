@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Cuerpo de POST /register y POST /login: {"username": "...", "password": "..."}
+struct Credentials {
+    std::string_view username;
+    std::string_view password;
+};
+
+// Lee las credenciales en una sola pasada sobre el body, sin construir un
+// nlohmann::json ni copiar los campos: username y password son vistas sobre
+// el body (o sobre un buffer interno si llevan escapes), válidas hasta la
+// siguiente llamada a parse().
+//
+// El veredicto es el mismo que daría nlohmann: se valida el documento entero
+// (UTF-8, escapes y surrogates, números que no caben en un double, BOM, el
+// resto de claves), las claves duplicadas se quedan con el último valor y un
+// documento que no es un objeto cuenta como campos ausentes. Se reutiliza de
+// una petición a otra (un parser por hilo) para no reservar memoria.
+class CredentialsParser {
+public:
+    enum class Status {
+        Ok,
+        Malformed,   // no es JSON válido (json::parse lanzaría)
+        Missing,     // falta username o password
+        NotString    // están, pero alguno no es un string
+    };
+
+    Status parse(std::string_view body, Credentials& out);
+
+private:
+    std::string m_unescaped;   // username/password con escapes, ya decodificados
+    std::string m_key;         // clave con escapes, ya decodificada
+    std::string m_nesting;     // cierres pendientes ('}' o ']') de los valores ignorados
+};
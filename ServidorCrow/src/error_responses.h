@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+// Errores de forma fija de la API, serializados en tiempo de compilación como
+// {"error":"<mensaje>","success":false}: los mismos bytes que daba
+// json{{"success", false}, {"error", ...}}.dump(). Son los caminos que más se
+// repiten bajo ataque (fuerza bruta contra /login, altas duplicadas, tokens
+// basura), así que no construyen JSON: el handler sólo copia el cuerpo.
+enum class ApiError {
+    InvalidJson,
+    RegisterFieldsRequired,
+    LoginFieldsRequired,
+    EmptyCredentials,
+    CredentialsTooLong,
+    UserExists,
+    InvalidCredentials,
+    RefreshTokenRequired,
+    RefreshTokenInvalid,
+    TokensRequired,
+    TokenNotRevocable,
+    InvalidPageLimit,
+    InvalidCursor,
+    UsersListBusy,
+    UsersListTooLarge,
+    LocalhostOnly,
+    KeysFileMissing,
+    InternalError,
+    // Middleware JwtAuth (401 con WWW-Authenticate)
+    TokenRequired,
+    TokenMalformed,
+    TokenBadSignature,
+    TokenExpired,
+    TokenRevoked,
+    TokenUnknownKey,
+    Count
+};
+
+class ErrorBody {
+public:
+    // Un mensaje con algo que escapar no compila (el throw no es constante)
+    constexpr ErrorBody(int status, std::string_view message) : m_status(status), m_message(message) {
+        append(R"({"error":")");
+        for (const char c : message) {
+            if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+                throw std::logic_error("mensaje de error con caracteres a escapar");
+            }
+        }
+        append(message);
+        append(R"(","success":false})");
+    }
+
+    constexpr int status() const { return m_status; }
+    constexpr std::string_view message() const { return m_message; }
+    constexpr std::string_view body() const { return std::string_view(m_text, m_size); }
+
+private:
+    static constexpr std::size_t kCapacity = 96;
+
+    constexpr void append(std::string_view text) {
+        if (m_size + text.size() > kCapacity) {
+            throw std::length_error("mensaje de error demasiado largo");
+        }
+        for (const char c : text) {
+            m_text[m_size++] = c;
+        }
+    }
+
+    int m_status;
+    std::string_view m_message;
+    char m_text[kCapacity] = {};
+    std::size_t m_size = 0;
+};
+
+// En el orden de ApiError
+inline constexpr ErrorBody kApiErrors[] = {
+    {400, "JSON inválido"},
+    {400, "Se requieren los campos: username y password"},
+    {400, "Se requieren username y password"},
+    {400, "Username y password no pueden estar vacíos"},
+    {400, "Username o password demasiado largos"},
+    {409, "El usuario ya existe"},
+    {401, "Credenciales inválidas"},
+    {400, "Se requiere refresh_token"},
+    {401, "Refresh token inválido o expirado"},
+    {400, "Se requiere tokens (array de strings)"},
+    {400, "El token no admite revocación (sin jti)"},
+    {400, "limit debe ser un entero positivo"},
+    {400, "Cursor inválido"},
+    {503, "Demasiados listados completos en curso; usa limit y cursor"},
+    {400, "Listado demasiado grande para enviarlo entero; usa limit y cursor"},
+    {403, "Sólo se permite desde localhost"},
+    {400, "JWT_KEYS_FILE no está configurado"},
+    {500, "Error interno del servidor"},
+    {401, "Se requiere un token"},
+    {401, "Token mal formado"},
+    {401, "Firma del token inválida"},
+    {401, "Token expirado"},
+    {401, "Token revocado"},
+    {401, "Clave de firma desconocida"},
+};
+static_assert(std::size(kApiErrors) == static_cast<std::size_t>(ApiError::Count), "falta un error en kApiErrors");
+
+constexpr const ErrorBody& api_error(ApiError error) {
+    return kApiErrors[static_cast<std::size_t>(error)];
+}
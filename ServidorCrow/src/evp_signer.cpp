@@ -0,0 +1,186 @@
+#include "evp_signer.h"
+
+#include "base64url.h"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/objects.h>
+#include <openssl/pem.h>
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kCoordinateSize = 32;  // P-256
+
+void check(int ok, const char* what) {
+    if (ok != 1) {
+        throw std::runtime_error(std::string("EvpSigner: ") + what + " falló");
+    }
+}
+
+struct MdCtxDeleter {
+    void operator()(EVP_MD_CTX* ctx) const { EVP_MD_CTX_free(ctx); }
+};
+
+using MdCtx = std::unique_ptr<EVP_MD_CTX, MdCtxDeleter>;
+
+MdCtx new_context() {
+    MdCtx ctx(EVP_MD_CTX_new());
+    if (!ctx) {
+        throw std::runtime_error("EvpSigner: EVP_MD_CTX_new falló");
+    }
+    return ctx;
+}
+
+// ES256 es sólo P-256: otras curvas de 256 bits (secp256k1, brainpoolP256r1)
+// pasan por EVP_PKEY_bits pero sus firmas no son ES256
+bool is_p256(EVP_PKEY* key) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    char name[64];
+    std::size_t length = 0;
+    return EVP_PKEY_get_group_name(key, name, sizeof(name), &length) == 1 &&
+           OBJ_sn2nid(name) == NID_X9_62_prime256v1;
+#else
+    const EC_KEY* ec = EVP_PKEY_get0_EC_KEY(key);
+    return ec && EC_GROUP_get_curve_name(EC_KEY_get0_group(ec)) == NID_X9_62_prime256v1;
+#endif
+}
+
+std::string base64url(const unsigned char* data, std::size_t size) {
+    std::string out;
+    base64url_encode(data, size, out);
+    return out;
+}
+
+}  // namespace
+
+EvpSigner::EvpSigner(EVP_PKEY* key) : m_key(key) {
+    if (!m_key) {
+        throw std::invalid_argument("EvpSigner: clave nula");
+    }
+    const int type = EVP_PKEY_base_id(m_key);
+    if (type == EVP_PKEY_EC && is_p256(m_key)) {
+        m_ec = true;
+    } else if (type == EVP_PKEY_ED25519) {
+        m_ec = false;
+    } else {
+        EVP_PKEY_free(m_key);
+        throw std::invalid_argument("EvpSigner: sólo se admiten claves P-256 (ES256) y Ed25519 (EdDSA)");
+    }
+}
+
+EvpSigner::~EvpSigner() {
+    EVP_PKEY_free(m_key);
+}
+
+EVP_PKEY* EvpSigner::read_private_key(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("EvpSigner: no se pudo abrir " + path);
+    }
+    EVP_PKEY* key = PEM_read_PrivateKey(file, nullptr, nullptr, nullptr);
+    std::fclose(file);
+    if (!key) {
+        throw std::runtime_error("EvpSigner: " + path + " no contiene una clave privada PEM");
+    }
+    return key;
+}
+
+const char* EvpSigner::alg() const {
+    return m_ec ? "ES256" : "EdDSA";
+}
+
+void EvpSigner::sign(const void* data, std::size_t size, unsigned char* out) const {
+    MdCtx ctx = new_context();
+    check(EVP_DigestSignInit(ctx.get(), nullptr, m_ec ? EVP_sha256() : nullptr, nullptr, m_key),
+          "EVP_DigestSignInit");
+
+    if (!m_ec) {
+        std::size_t length = signature_size();
+        check(EVP_DigestSign(ctx.get(), out, &length, static_cast<const unsigned char*>(data), size),
+              "EVP_DigestSign");
+        return;
+    }
+
+    // ECDSA devuelve DER; JWS quiere r||s con relleno a 32 bytes cada uno
+    unsigned char der[80];
+    std::size_t length = sizeof(der);
+    check(EVP_DigestSign(ctx.get(), der, &length, static_cast<const unsigned char*>(data), size), "EVP_DigestSign");
+    const unsigned char* p = der;
+    ECDSA_SIG* sig = d2i_ECDSA_SIG(nullptr, &p, static_cast<long>(length));
+    if (!sig) {
+        throw std::runtime_error("EvpSigner: firma ECDSA ilegible");
+    }
+    const BIGNUM* r = nullptr;
+    const BIGNUM* s = nullptr;
+    ECDSA_SIG_get0(sig, &r, &s);
+    const bool ok = BN_bn2binpad(r, out, kCoordinateSize) == static_cast<int>(kCoordinateSize) &&
+                    BN_bn2binpad(s, out + kCoordinateSize, kCoordinateSize) == static_cast<int>(kCoordinateSize);
+    ECDSA_SIG_free(sig);
+    check(ok ? 1 : 0, "BN_bn2binpad");
+}
+
+bool EvpSigner::verify(const void* data, std::size_t size, const unsigned char* signature,
+                       std::size_t signature_size) const {
+    if (signature_size != this->signature_size()) {
+        return false;
+    }
+    MdCtx ctx = new_context();
+    check(EVP_DigestVerifyInit(ctx.get(), nullptr, m_ec ? EVP_sha256() : nullptr, nullptr, m_key),
+          "EVP_DigestVerifyInit");
+
+    if (!m_ec) {
+        return EVP_DigestVerify(ctx.get(), signature, signature_size, static_cast<const unsigned char*>(data),
+                                size) == 1;
+    }
+
+    // r||s -> DER para OpenSSL
+    ECDSA_SIG* sig = ECDSA_SIG_new();
+    BIGNUM* r = BN_bin2bn(signature, kCoordinateSize, nullptr);
+    BIGNUM* s = BN_bin2bn(signature + kCoordinateSize, kCoordinateSize, nullptr);
+    if (!sig || !r || !s || ECDSA_SIG_set0(sig, r, s) != 1) {
+        BN_free(r);
+        BN_free(s);
+        ECDSA_SIG_free(sig);
+        throw std::runtime_error("EvpSigner: ECDSA_SIG_set0 falló");
+    }
+    unsigned char* der = nullptr;
+    const int der_size = i2d_ECDSA_SIG(sig, &der);
+    ECDSA_SIG_free(sig);
+    if (der_size <= 0) {
+        throw std::runtime_error("EvpSigner: i2d_ECDSA_SIG falló");
+    }
+    const int result = EVP_DigestVerify(ctx.get(), der, static_cast<std::size_t>(der_size),
+                                        static_cast<const unsigned char*>(data), size);
+    OPENSSL_free(der);
+    return result == 1;
+}
+
+std::string EvpSigner::public_jwk_members() const {
+    if (!m_ec) {
+        unsigned char raw[32];
+        std::size_t length = sizeof(raw);
+        check(EVP_PKEY_get_raw_public_key(m_key, raw, &length), "EVP_PKEY_get_raw_public_key");
+        return R"("kty":"OKP","crv":"Ed25519","x":")" + base64url(raw, length) + '"';
+    }
+
+    // Punto sin comprimir: 0x04 || X || Y
+    unsigned char* point = nullptr;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    const std::size_t length = EVP_PKEY_get1_encoded_public_key(m_key, &point);
+#else
+    const std::size_t length = EVP_PKEY_get1_tls_encodedpoint(m_key, &point);
+#endif
+    if (length != 1 + 2 * kCoordinateSize || point[0] != 0x04) {
+        OPENSSL_free(point);
+        throw std::runtime_error("EvpSigner: punto público inesperado");
+    }
+    const std::string members = R"("kty":"EC","crv":"P-256","x":")" + base64url(point + 1, kCoordinateSize) +
+                                R"(","y":")" + base64url(point + 1 + kCoordinateSize, kCoordinateSize) + '"';
+    OPENSSL_free(point);
+    return members;
+}
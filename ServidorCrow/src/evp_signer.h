@@ -0,0 +1,43 @@
+#pragma once
+
+#include "token_signer.h"
+
+#include <openssl/evp.h>
+
+#include <string>
+
+// Firmas asimétricas con EVP_PKEY de OpenSSL: ES256 (ECDSA P-256 + SHA-256)
+// y EdDSA (Ed25519).
+//
+// Con estos algoritmos los demás servicios verifican los tokens por su
+// cuenta con la clave pública del JWKS, sin compartir el secreto.
+// ES256 en JWS es r||s de 32 bytes cada uno, no el DER que devuelve OpenSSL;
+// la conversión se hace aquí en ambos sentidos.
+class EvpSigner : public TokenSigner {
+public:
+    // Toma posesión de key; el algoritmo se deduce del tipo de clave
+    explicit EvpSigner(EVP_PKEY* key);
+    ~EvpSigner() override;
+
+    EvpSigner(const EvpSigner&) = delete;
+    EvpSigner& operator=(const EvpSigner&) = delete;
+
+    // Clave privada en PEM (PKCS#8 o el formato tradicional de EC)
+    static EVP_PKEY* read_private_key(const std::string& path);
+
+    const char* alg() const override;
+    std::size_t signature_size() const override { return 64; }
+    void sign(const void* data, std::size_t size, unsigned char* out) const override;
+    bool verify(const void* data, std::size_t size, const unsigned char* signature,
+                std::size_t signature_size) const override;
+    std::string public_jwk_members() const override;
+
+    using TokenSigner::sign;
+    using TokenSigner::verify;
+
+    EVP_PKEY* key() const { return m_key; }
+
+private:
+    EVP_PKEY* m_key;
+    bool m_ec;  // ES256; si no, Ed25519
+};
@@ -0,0 +1,115 @@
+#include "group_committer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+
+GroupCommitter::GroupCommitter(UserStore& store, Config config)
+    : m_store(store), m_config(config), m_thread([this] { run(); }) {}
+
+GroupCommitter::~GroupCommitter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+}
+
+std::future<bool> GroupCommitter::submit(User user) {
+    Pending pending{std::move(user), {}};
+    std::future<bool> result = pending.done.get_future();
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(pending));
+        // Sólo hace falta despertar al committer con el primero y al llenar el lote
+        wake = m_queue.size() == 1 || m_queue.size() >= m_config.max_batch;
+    }
+    if (wake) {
+        m_wakeup.notify_one();
+    }
+    return result;
+}
+
+GroupCommitter::Stats GroupCommitter::stats() const {
+    Stats s;
+    s.commits = m_commits.load(std::memory_order_relaxed);
+    s.records = m_records.load(std::memory_order_relaxed);
+    s.max_records_per_commit = m_max_records.load(std::memory_order_relaxed);
+    s.commit_ns_total = m_commit_ns_total.load(std::memory_order_relaxed);
+    return s;
+}
+
+void GroupCommitter::run() {
+    const std::size_t max_batch = std::max<std::size_t>(m_config.max_batch, 1);
+    std::vector<Pending> batch;
+    bool carried = false;  // quedó cola del lote anterior: ya esperó su commit
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_wakeup.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            return;  // parada con la cola vacía
+        }
+
+        // Esperar a llenar el lote, como mucho max_delay desde el primer registro
+        if (!carried) {
+            const auto deadline = std::chrono::steady_clock::now() + m_config.max_delay;
+            m_wakeup.wait_until(lock, deadline, [this, max_batch] {
+                return m_stopping || m_queue.size() >= max_batch;
+            });
+        }
+
+        // Como mucho max_batch por commit; el resto sale en el siguiente
+        if (m_queue.size() <= max_batch) {
+            batch.swap(m_queue);
+        } else {
+            const auto end = m_queue.begin() + static_cast<std::ptrdiff_t>(max_batch);
+            batch.assign(std::make_move_iterator(m_queue.begin()), std::make_move_iterator(end));
+            m_queue.erase(m_queue.begin(), end);
+        }
+        carried = !m_queue.empty();
+        lock.unlock();
+        commit(batch);
+        batch.clear();
+        lock.lock();
+    }
+}
+
+void GroupCommitter::commit(std::vector<Pending>& batch) {
+    std::vector<User> users;
+    users.reserve(batch.size());
+    for (auto& pending : batch) {
+        users.push_back(std::move(pending.user));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t resolved = 0;  // los anteriores ya tienen valor: set_exception lanzaría future_error
+    try {
+        const std::vector<bool> inserted = m_store.insert_batch(users);
+        if (inserted.size() != batch.size()) {
+            throw std::logic_error("insert_batch devolvió un resultado por registro distinto");
+        }
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            resolved = i + 1;  // si set_value lanza, este promise no se vuelve a tocar
+            batch[i].done.set_value(inserted[i]);
+        }
+    } catch (...) {
+        for (std::size_t i = resolved; i < batch.size(); ++i) {
+            batch[i].done.set_exception(std::current_exception());
+        }
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    const std::uint64_t count = batch.size();
+    m_commits.fetch_add(1, std::memory_order_relaxed);
+    m_records.fetch_add(count, std::memory_order_relaxed);
+    m_commit_ns_total.fetch_add(static_cast<std::uint64_t>(ns.count()), std::memory_order_relaxed);
+    std::uint64_t max = m_max_records.load(std::memory_order_relaxed);
+    while (count > max && !m_max_records.compare_exchange_weak(max, count, std::memory_order_relaxed)) {
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "user_store.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Etapa write-behind para /register sobre un motor durable.
+//
+// Los handlers encolan el User y esperan el futuro; un hilo de fondo agrupa
+// lo encolado y lo escribe con un único insert_batch (una transacción o un
+// fsync) cuando se juntan `max_batch` registros o pasan `max_delay` desde el
+// primero (nunca más de `max_batch` por commit). El futuro se resuelve sólo
+// cuando el lote ya es durable, así que el 201 nunca se envía antes de tiempo.
+class GroupCommitter {
+public:
+    struct Config {
+        std::size_t max_batch = 256;
+        std::chrono::microseconds max_delay{2000};
+    };
+
+    struct Stats {
+        std::uint64_t commits = 0;
+        std::uint64_t records = 0;
+        std::uint64_t max_records_per_commit = 0;
+        std::uint64_t commit_ns_total = 0;
+    };
+
+    GroupCommitter(UserStore& store, Config config);
+    ~GroupCommitter();
+
+    GroupCommitter(const GroupCommitter&) = delete;
+    GroupCommitter& operator=(const GroupCommitter&) = delete;
+
+    // Encola el usuario; el futuro vale lo mismo que insert_if_absent
+    std::future<bool> submit(User user);
+
+    const Config& config() const { return m_config; }
+    Stats stats() const;
+
+private:
+    struct Pending {
+        User user;
+        std::promise<bool> done;
+    };
+
+    void run();
+    void commit(std::vector<Pending>& batch);
+
+    UserStore& m_store;
+    const Config m_config;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::vector<Pending> m_queue;
+    bool m_stopping = false;
+
+    std::atomic<std::uint64_t> m_commits{0};
+    std::atomic<std::uint64_t> m_records{0};
+    std::atomic<std::uint64_t> m_max_records{0};
+    std::atomic<std::uint64_t> m_commit_ns_total{0};
+
+    std::thread m_thread;  // último: arranca con todo lo anterior inicializado
+};
@@ -0,0 +1,135 @@
+#include "hs256_signer.h"
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64;
+
+std::atomic<std::uint64_t> g_next_instance{1};
+
+EVP_MD_CTX* new_context() {
+    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+    if (!ctx) {
+        throw std::runtime_error("Hs256Signer: EVP_MD_CTX_new falló");
+    }
+    return ctx;
+}
+
+void check(int ok, const char* what) {
+    if (ok != 1) {
+        throw std::runtime_error(std::string("Hs256Signer: ") + what + " falló");
+    }
+}
+
+// Estado SHA-256 tras absorber el bloque (clave ^ pad)
+EVP_MD_CTX* padded_state(const unsigned char* key, unsigned char pad) {
+    unsigned char block[kBlockSize];
+    for (std::size_t i = 0; i < kBlockSize; ++i) {
+        block[i] = key[i] ^ pad;
+    }
+    EVP_MD_CTX* ctx = new_context();
+    check(EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr), "EVP_DigestInit_ex");
+    check(EVP_DigestUpdate(ctx, block, kBlockSize), "EVP_DigestUpdate");
+    OPENSSL_cleanse(block, sizeof(block));
+    return ctx;
+}
+
+}  // namespace
+
+// Copias por hilo de los estados de una clave
+struct Hs256Signer::EvpContexts {
+    std::uint64_t instance = 0;
+    std::uint64_t last_use = 0;
+    EVP_MD_CTX* inner = nullptr;
+    EVP_MD_CTX* outer = nullptr;
+    EVP_MD_CTX* work = nullptr;
+
+    ~EvpContexts() {
+        EVP_MD_CTX_free(inner);
+        EVP_MD_CTX_free(outer);
+        EVP_MD_CTX_free(work);
+    }
+};
+
+namespace {
+
+// Claves con estado propio en cada hilo: durante una rotación conviven la
+// activa y las anteriores, y alternar entre ellas no debe recopiar estados
+constexpr std::size_t kThreadKeys = 4;
+
+}  // namespace
+
+Hs256Signer::Hs256Signer(const std::string& key) : m_instance(g_next_instance.fetch_add(1)) {
+    // Claves de más de un bloque se sustituyen por su hash (RFC 2104)
+    unsigned char block[kBlockSize] = {};
+    if (key.size() > kBlockSize) {
+        unsigned int length = 0;
+        check(EVP_Digest(key.data(), key.size(), block, &length, EVP_sha256(), nullptr), "EVP_Digest");
+    } else {
+        std::memcpy(block, key.data(), key.size());
+    }
+    m_inner = padded_state(block, 0x36);
+    m_outer = padded_state(block, 0x5c);
+    OPENSSL_cleanse(block, sizeof(block));
+}
+
+Hs256Signer::~Hs256Signer() {
+    EVP_MD_CTX_free(m_inner);
+    EVP_MD_CTX_free(m_outer);
+}
+
+Hs256Signer::EvpContexts& Hs256Signer::thread_contexts() const {
+    thread_local EvpContexts slots[kThreadKeys];
+    thread_local std::uint64_t uses = 0;
+    ++uses;
+
+    // Se reemplaza la menos usada recientemente
+    EvpContexts* victim = &slots[0];
+    for (EvpContexts& slot : slots) {
+        if (slot.instance == m_instance) {
+            slot.last_use = uses;
+            return slot;
+        }
+        if (slot.last_use < victim->last_use) {
+            victim = &slot;
+        }
+    }
+
+    if (!victim->work) {
+        victim->inner = new_context();
+        victim->outer = new_context();
+        victim->work = new_context();
+    }
+    check(EVP_MD_CTX_copy_ex(victim->inner, m_inner), "EVP_MD_CTX_copy_ex");
+    check(EVP_MD_CTX_copy_ex(victim->outer, m_outer), "EVP_MD_CTX_copy_ex");
+    victim->instance = m_instance;
+    victim->last_use = uses;
+    return *victim;
+}
+
+void Hs256Signer::sign(const void* data, std::size_t size, unsigned char* out) const {
+    EvpContexts& ctx = thread_contexts();
+    unsigned char inner_digest[kDigestSize];
+    unsigned int length = 0;
+
+    check(EVP_MD_CTX_copy_ex(ctx.work, ctx.inner), "EVP_MD_CTX_copy_ex");
+    check(EVP_DigestUpdate(ctx.work, data, size), "EVP_DigestUpdate");
+    check(EVP_DigestFinal_ex(ctx.work, inner_digest, &length), "EVP_DigestFinal_ex");
+
+    check(EVP_MD_CTX_copy_ex(ctx.work, ctx.outer), "EVP_MD_CTX_copy_ex");
+    check(EVP_DigestUpdate(ctx.work, inner_digest, sizeof(inner_digest)), "EVP_DigestUpdate");
+    check(EVP_DigestFinal_ex(ctx.work, out, &length), "EVP_DigestFinal_ex");
+}
+
+bool Hs256Signer::verify(const void* data, std::size_t size, const unsigned char* signature,
+                         std::size_t signature_size) const {
+    unsigned char expected[kDigestSize];
+    sign(data, size, expected);
+    return signature_size == kDigestSize && CRYPTO_memcmp(expected, signature, kDigestSize) == 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "token_signer.h"
+
+#include <openssl/evp.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// HMAC-SHA256 con la clave preparada una sola vez.
+//
+// HMAC(k, m) = H((k ^ opad) || H((k ^ ipad) || m)). Los dos prefijos de 64
+// bytes sólo dependen de la clave, así que el estado SHA-256 tras absorberlos
+// se calcula en el constructor y cada hilo guarda su propia copia (junto con
+// un contexto de trabajo) para las últimas claves que usó. Firmar es copiar
+// ese estado y procesar el mensaje, sin derivar la clave ni crear contextos
+// de OpenSSL en cada petición.
+class Hs256Signer : public TokenSigner {
+public:
+    static constexpr std::size_t kDigestSize = 32;
+
+    explicit Hs256Signer(const std::string& key);
+    ~Hs256Signer() override;
+
+    Hs256Signer(const Hs256Signer&) = delete;
+    Hs256Signer& operator=(const Hs256Signer&) = delete;
+
+    const char* alg() const override { return "HS256"; }
+    std::size_t signature_size() const override { return kDigestSize; }
+
+    // Escribe los 32 bytes del HMAC de data en out
+    void sign(const void* data, std::size_t size, unsigned char* out) const override;
+
+    // Recalcula el HMAC y compara en tiempo constante
+    bool verify(const void* data, std::size_t size, const unsigned char* signature,
+                std::size_t signature_size) const override;
+
+    using TokenSigner::sign;
+    using TokenSigner::verify;
+
+private:
+    struct EvpContexts;
+
+    EvpContexts& thread_contexts() const;
+
+    std::uint64_t m_instance;  // identifica la clave en las copias por hilo
+    EVP_MD_CTX* m_inner;       // estado tras absorber k ^ ipad
+    EVP_MD_CTX* m_outer;       // estado tras absorber k ^ opad
+};
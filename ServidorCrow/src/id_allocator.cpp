@@ -0,0 +1,45 @@
+#include "id_allocator.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Bloque reservado por el hilo actual
+struct LocalBlock {
+    const IdAllocator* owner = nullptr;
+    std::uint64_t generation = 0;
+    std::int64_t next = 0;
+    std::int64_t end = 0;
+};
+
+thread_local LocalBlock t_block;
+
+}  // namespace
+
+IdAllocator::IdAllocator(int first_id, int block_size)
+    : m_next(first_id), m_block_size(block_size > 0 ? block_size : 1) {}
+
+int IdAllocator::next() {
+    const std::uint64_t generation = m_generation.load(std::memory_order_acquire);
+    LocalBlock& block = t_block;
+
+    if (block.owner != this || block.generation != generation || block.next == block.end) {
+        block.owner = this;
+        block.generation = generation;
+        block.next = m_next.fetch_add(m_block_size, std::memory_order_relaxed);
+        block.end = block.next + m_block_size;
+    }
+
+    if (block.next > std::numeric_limits<int>::max()) {
+        throw std::overflow_error("IdAllocator: ids agotados");
+    }
+    return static_cast<int>(block.next++);
+}
+
+void IdAllocator::advance_to(int floor) {
+    std::int64_t current = m_next.load(std::memory_order_relaxed);
+    while (current < floor && !m_next.compare_exchange_weak(current, floor, std::memory_order_relaxed)) {
+    }
+    m_generation.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Asignador de ids de usuario sin contención.
+//
+// Cada hilo reserva un bloque de ids consecutivos con un único fetch_add sobre
+// el contador global y luego los reparte localmente, así la línea de caché
+// compartida sólo se toca una vez por bloque. Los huecos quedan acotados a
+// (bloque - 1) ids por hilo, suficiente para el listado de /users.
+class IdAllocator {
+public:
+    explicit IdAllocator(int first_id = 1, int block_size = 64);
+
+    // Devuelve un id nuevo y único
+    int next();
+
+    // Garantiza que los próximos ids sean >= floor (p. ej. al recuperar datos
+    // persistidos tras un reinicio). Invalida los bloques ya repartidos.
+    void advance_to(int floor);
+
+    int block_size() const { return m_block_size; }
+
+private:
+    alignas(64) std::atomic<std::int64_t> m_next;
+    alignas(64) std::atomic<std::uint64_t> m_generation{0};  // sólo lectura en el camino rápido
+    const int m_block_size;
+};
@@ -0,0 +1,103 @@
+#include "id_index.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+// Posición del bit 1 más bajo (bits != 0)
+unsigned lowest_bit(std::uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+}  // namespace
+
+IdIndex::IdIndex() : m_segments(new std::atomic<Segment*>[kSegments]()) {}
+
+IdIndex::~IdIndex() {
+    for (std::size_t i = 0; i < kSegments; ++i) {
+        delete m_segments[i].load(std::memory_order_relaxed);
+    }
+}
+
+void IdIndex::insert(int id) {
+    if (id < 0) {
+        return;
+    }
+    const auto value = static_cast<std::size_t>(id);
+    Segment* s = segment(value >> kSegmentBits);
+    const std::size_t bit = value & (kSegmentIds - 1);
+    const std::size_t word = bit / 64;
+    // Primero el bit del id y después el del resumen: quien ve el resumen ve el id
+    s->words[word].fetch_or(std::uint64_t{1} << (bit % 64), std::memory_order_release);
+    s->summary[word / 64].fetch_or(std::uint64_t{1} << (word % 64), std::memory_order_release);
+}
+
+int IdIndex::next(int after) const {
+    std::size_t first = after < 0 ? 0 : static_cast<std::size_t>(after) + 1;
+    for (std::size_t index = first >> kSegmentBits; index < kSegments; ++index) {
+        const Segment* s = m_segments[index].load(std::memory_order_acquire);
+        if (s) {
+            const int found = first_in(*s, index << kSegmentBits, first & (kSegmentIds - 1));
+            if (found != kNone) {
+                return found;
+            }
+        }
+        first = 0;
+    }
+    return kNone;
+}
+
+std::size_t IdIndex::memory_bytes() const {
+    return kSegments * sizeof(std::atomic<Segment*>) +
+           m_allocated.load(std::memory_order_relaxed) * sizeof(Segment);
+}
+
+IdIndex::Segment* IdIndex::segment(std::size_t index) {
+    Segment* s = m_segments[index].load(std::memory_order_acquire);
+    if (s) {
+        return s;
+    }
+    // Sólo lo reserva el primer id del rango; si dos hilos compiten, uno descarta el suyo
+    auto fresh = std::make_unique<Segment>();
+    if (m_segments[index].compare_exchange_strong(s, fresh.get(), std::memory_order_acq_rel)) {
+        m_allocated.fetch_add(1, std::memory_order_relaxed);
+        return fresh.release();
+    }
+    return s;
+}
+
+int IdIndex::first_in(const Segment& segment, std::size_t base, std::size_t first) {
+    std::size_t word = first / 64;
+    // Lo que queda de la palabra de `first`
+    std::uint64_t bits =
+        segment.words[word].load(std::memory_order_acquire) & (~std::uint64_t{0} << (first % 64));
+    if (bits) {
+        return static_cast<int>(base + word * 64 + lowest_bit(bits));
+    }
+    // El resto, saltando con el resumen las palabras vacías
+    std::size_t summary_word = (word + 1) / 64;
+    std::uint64_t summary = 0;
+    if (summary_word < kSummaryWords) {
+        summary = segment.summary[summary_word].load(std::memory_order_acquire) &
+                  (~std::uint64_t{0} << ((word + 1) % 64));
+    }
+    while (summary_word < kSummaryWords) {
+        if (summary) {
+            word = summary_word * 64 + lowest_bit(summary);
+            bits = segment.words[word].load(std::memory_order_acquire);
+            return static_cast<int>(base + word * 64 + lowest_bit(bits));
+        }
+        if (++summary_word < kSummaryWords) {
+            summary = segment.summary[summary_word].load(std::memory_order_acquire);
+        }
+    }
+    return kNone;
+}
@@ -0,0 +1,74 @@
+#include "json_writer.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+// Lo que escapa nlohmann: comillas, barra invertida y controles (< 0x20).
+// Con la tabla, el bucle sobre el texto es una carga y un salto por byte.
+struct EscapeTable {
+    bool escape[256] = {};
+
+    constexpr EscapeTable() {
+        for (int c = 0; c < 0x20; ++c) {
+            escape[c] = true;
+        }
+        escape[static_cast<unsigned char>('"')] = true;
+        escape[static_cast<unsigned char>('\\')] = true;
+    }
+};
+
+constexpr EscapeTable kEscape;
+
+constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+constexpr std::uint64_t kHighBits = 0x8080808080808080ull;
+
+// ¿Algún byte de la palabra < n? (n <= 0x80; exacto, sin falsos positivos)
+constexpr std::uint64_t any_less(std::uint64_t word, std::uint64_t n) {
+    return (word - kOnes * n) & ~word & kHighBits;
+}
+
+// ¿Algún byte que escapar entre estos 8? Es lo habitual que no (tokens, nombres)
+bool any_escape(const char* bytes) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return any_less(word, 0x20) | any_less(word ^ (kOnes * '"'), 1) | any_less(word ^ (kOnes * '\\'), 1);
+}
+
+}  // namespace
+
+void JsonWriter::append_escaped(std::string& out, std::string_view text) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        // De 8 en 8 mientras no haya nada que escapar
+        while (i + 8 <= text.size() && !any_escape(text.data() + i)) {
+            i += 8;
+        }
+        if (i == text.size()) {
+            break;
+        }
+        const auto byte = static_cast<unsigned char>(text[i]);
+        if (!kEscape.escape[byte]) {
+            continue;
+        }
+        // Los tramos sin escapes se copian de una vez
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch (byte) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', kHex[byte >> 4], kHex[byte & 15]};
+                out.append(escaped, sizeof(escaped));
+            }
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+}
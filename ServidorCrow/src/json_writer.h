@@ -0,0 +1,105 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Escritura directa de cuerpos JSON de forma fija, sin nlohmann::json: cada
+// fragmento se añade ya escapado a un único string, reservado de antemano
+// con el tamaño esperado, que al final se entrega con take() (se mueve a
+// crow::response sin copiarlo).
+//
+// El resultado es idéntico byte a byte a dump() de nlohmann siempre que las
+// claves se escriban en SU orden, el alfabético (su objeto es un std::map):
+// '/' sin escapar, controles como \u00xx en minúsculas y el resto de bytes
+// tal cual. Los strings deben ser UTF-8 válido (nlohmann lanzaría); aquí
+// todos vienen de JSON ya validado al entrar.
+//
+//   JsonWriter out(64);
+//   out.begin_object().key("id").value(1).key("username").value("juan").end_object();
+//   crow::response(200, out.take());   // {"id":1,"username":"juan"}
+class JsonWriter {
+public:
+    explicit JsonWriter(std::size_t reserve = 0) { m_out.reserve(reserve); }
+
+    JsonWriter& begin_object() { return open('{'); }
+    JsonWriter& end_object() { return close('}'); }
+    JsonWriter& begin_array() { return open('['); }
+    JsonWriter& end_array() { return close(']'); }
+
+    // La clave se escribe sin escapar: siempre es un literal del código
+    JsonWriter& key(std::string_view name) {
+        separator();
+        m_out += '"';
+        m_out += name;
+        m_out += "\":";
+        m_need_comma = false;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view text) {
+        separator();
+        m_out += '"';
+        append_escaped(m_out, text);
+        m_out += '"';
+        return *this;
+    }
+
+    // Sin esta sobrecarga, un literal iría a value(bool) (conversión estándar)
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+
+    JsonWriter& value(bool flag) {
+        separator();
+        m_out += flag ? "true" : "false";
+        return *this;
+    }
+
+    template <typename Int, std::enable_if_t<std::is_integral_v<Int> && !std::is_same_v<Int, bool>, int> = 0>
+    JsonWriter& value(Int number) {
+        separator();
+        char digits[24];
+        const char* end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+        m_out.append(digits, static_cast<std::size_t>(end - digits));
+        return *this;
+    }
+
+    // Fragmento ya serializado (un valor JSON completo)
+    JsonWriter& raw(std::string_view json) {
+        separator();
+        m_out += json;
+        return *this;
+    }
+
+    std::size_t size() const { return m_out.size(); }
+
+    std::string take() { return std::move(m_out); }
+
+    // Añade `text` con los escapes de nlohmann (sin las comillas)
+    static void append_escaped(std::string& out, std::string_view text);
+
+private:
+    JsonWriter& open(char bracket) {
+        separator();
+        m_out += bracket;
+        m_need_comma = false;
+        return *this;
+    }
+
+    JsonWriter& close(char bracket) {
+        m_out += bracket;
+        m_need_comma = true;
+        return *this;
+    }
+
+    void separator() {
+        if (m_need_comma) {
+            m_out += ',';
+        }
+        m_need_comma = true;
+    }
+
+    std::string m_out;
+    bool m_need_comma = false;
+};
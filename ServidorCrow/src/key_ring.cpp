@@ -0,0 +1,133 @@
+#include "key_ring.h"
+
+#include "base64url.h"
+#include "evp_signer.h"
+#include "hs256_signer.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// El kid va tal cual en el header JSON: sólo caracteres que no se escapan
+bool valid_kid(const std::string& kid) {
+    if (kid.empty() || kid.size() > 64) {
+        return false;
+    }
+    for (const char c : kid) {
+        const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' ||
+                        c == '_' || c == '.';
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+KeyRing::Key::Key(std::string kid_, std::unique_ptr<TokenSigner> signer_)
+    : kid(std::move(kid_)), signer(std::move(signer_)) {
+    // Mismo orden de claves que picojson: alg, kid, typ
+    const std::string json = R"({"alg":")" + std::string(signer->alg()) + R"(","kid":")" + kid + R"(","typ":"JWS"})";
+    base64url_encode(json.data(), json.size(), header);
+    header += '.';
+}
+
+const KeyRing::Key* KeyRing::Keys::find(std::string_view kid) const {
+    const auto it = by_kid.find(kid);
+    return it == by_kid.end() ? nullptr : it->second;
+}
+
+KeyRing::KeyRing(const std::vector<Spec>& keys) {
+    reload(keys);
+}
+
+void KeyRing::reload(const std::vector<Spec>& keys) {
+    std::lock_guard<std::mutex> lock(m_reload_mutex);
+    auto next = build(keys, m_versions.size() + 1);
+    m_current.store(next.get(), std::memory_order_release);
+    m_versions.push_back(std::move(next));
+}
+
+std::vector<KeyRing::Spec> KeyRing::parse_file(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("KeyRing: no se pudo abrir " + path);
+    }
+    std::vector<Spec> specs;
+    std::string line;
+    for (int number = 1; std::getline(in, line); ++number) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        Spec spec;
+        std::string third;
+        if (!(fields >> spec.kid >> spec.key)) {
+            throw std::runtime_error("KeyRing: línea " + std::to_string(number) + " inválida en " + path);
+        }
+        if (fields >> third) {
+            spec.alg = std::move(spec.key);
+            spec.key = std::move(third);
+        }
+        specs.push_back(std::move(spec));
+    }
+    return specs;
+}
+
+std::unique_ptr<KeyRing::Keys> KeyRing::build(const std::vector<Spec>& specs, std::uint64_t version) {
+    if (specs.empty()) {
+        throw std::invalid_argument("KeyRing: se necesita al menos una clave");
+    }
+    auto keys = std::make_unique<Keys>();
+    keys->version = version;
+    for (const Spec& spec : specs) {
+        if (!valid_kid(spec.kid)) {
+            throw std::invalid_argument("KeyRing: kid inválido '" + spec.kid + "'");
+        }
+        if (spec.key.empty()) {
+            throw std::invalid_argument("KeyRing: clave vacía para '" + spec.kid + "'");
+        }
+        keys->keys.push_back(std::make_unique<Key>(spec.kid, make_signer(spec)));
+        const Key* key = keys->keys.back().get();
+        if (!keys->by_kid.emplace(key->kid, key).second) {
+            throw std::invalid_argument("KeyRing: kid repetido '" + spec.kid + "'");
+        }
+    }
+    keys->active = keys->keys.back().get();
+
+    // JWKS con las claves públicas (las HS256 no se publican)
+    keys->jwks = R"({"keys":[)";
+    bool first = true;
+    for (const auto& key : keys->keys) {
+        const std::string members = key->signer->public_jwk_members();
+        if (members.empty()) {
+            continue;
+        }
+        keys->jwks += first ? "{" : ",{";
+        keys->jwks += members;
+        keys->jwks += R"(,"use":"sig","alg":")" + std::string(key->signer->alg()) + R"(","kid":")" + key->kid + R"("})";
+        first = false;
+    }
+    keys->jwks += "]}";
+    return keys;
+}
+
+std::unique_ptr<TokenSigner> KeyRing::make_signer(const Spec& spec) {
+    if (spec.alg == "HS256") {
+        return std::make_unique<Hs256Signer>(spec.key);
+    }
+    if (spec.alg == "ES256" || spec.alg == "EdDSA") {
+        auto signer = std::make_unique<EvpSigner>(EvpSigner::read_private_key(spec.key));
+        if (spec.alg != signer->alg()) {
+            throw std::invalid_argument("KeyRing: la clave de '" + spec.kid + "' no es " + spec.alg);
+        }
+        return signer;
+    }
+    throw std::invalid_argument("KeyRing: algoritmo desconocido '" + spec.alg + "' para '" + spec.kid + "'");
+}
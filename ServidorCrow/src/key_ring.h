@@ -0,0 +1,79 @@
+#pragma once
+
+#include "token_signer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Claves de firma de los tokens, identificadas por su kid.
+//
+// Los tokens nuevos se firman con la clave activa y llevan su kid en el
+// header; al verificar, el kid elige la clave con una búsqueda O(1). Rotar es
+// añadir una clave nueva (pasa a ser la activa) y conservar las anteriores
+// hasta que caduquen sus tokens, así nadie tiene que volver a hacer login.
+//
+// Cada clave puede ser HS256 (secreto compartido) o asimétrica, ES256 o
+// EdDSA (clave privada PEM); las asimétricas se publican en el JWKS, cuyo
+// cuerpo se serializa una vez por juego de claves.
+//
+// Cada recarga publica un juego de claves inmutable con un intercambio de
+// puntero, así que leer no toma locks. Los juegos anteriores se conservan
+// hasta destruir el KeyRing (las recargas son esporádicas y manuales).
+class KeyRing {
+public:
+    struct Spec {
+        std::string kid;
+        std::string key;            // secreto (HS256) o ruta de la clave privada PEM
+        std::string alg = "HS256";  // HS256, ES256 o EdDSA
+    };
+
+    struct Key {
+        std::string kid;
+        std::unique_ptr<TokenSigner> signer;
+        std::string header;  // header del token ya codificado en base64url, con el '.'
+
+        Key(std::string kid, std::unique_ptr<TokenSigner> signer);
+    };
+
+    struct Keys {
+        std::uint64_t version;
+        std::vector<std::unique_ptr<Key>> keys;
+        std::unordered_map<std::string_view, const Key*> by_kid;
+        const Key* active;
+        std::string jwks;  // {"keys":[...]} con las claves públicas
+
+        // nullptr si el kid no está en el juego
+        const Key* find(std::string_view kid) const;
+    };
+
+    // La última clave de la lista es la activa
+    explicit KeyRing(const std::vector<Spec>& keys);
+
+    // Sustituye el juego de claves; lanza si la lista no es válida
+    void reload(const std::vector<Spec>& keys);
+
+    // Juego actual; la referencia es válida mientras viva el KeyRing
+    const Keys& current() const { return *m_current.load(std::memory_order_acquire); }
+
+    // Lee un archivo de claves, una por línea: "<kid> <secreto>" (HS256) o
+    // "<kid> <alg> <secreto o ruta PEM>"; las líneas vacías y las que
+    // empiezan por '#' se ignoran. La última es la activa.
+    static std::vector<Spec> parse_file(const std::string& path);
+
+    // kid de los tokens sin kid (emitidos antes de la rotación de claves)
+    static constexpr const char* kDefaultKid = "default";
+
+private:
+    static std::unique_ptr<Keys> build(const std::vector<Spec>& specs, std::uint64_t version);
+    static std::unique_ptr<TokenSigner> make_signer(const Spec& spec);
+
+    std::atomic<const Keys*> m_current{nullptr};
+    std::mutex m_reload_mutex;
+    std::vector<std::unique_ptr<Keys>> m_versions;
+};
@@ -0,0 +1,164 @@
+#include "logged_user_store.h"
+
+#include <iostream>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+LoggedUserStore::LoggedUserStore(const std::string& log_path, const std::string& snapshot_path,
+                                 unsigned replay_threads)
+    : m_log(log_path), m_snapshot_path(snapshot_path) {
+    const auto start = std::chrono::steady_clock::now();
+    auto load = [&](std::vector<User>& batch) { m_memory.bulk_load(batch, replay_threads); };
+
+    // Dimensionar los índices de una vez: el log contiene todas las altas
+    // (registro típico ~32 bytes)
+    m_memory.reserve(m_log.size_on_disk() / 32);
+
+    // 1. Último snapshot; si está dañado o es de un log más largo que este
+    // (restaurado de una copia, recortado) se ignora y se reproduce el log entero
+    std::uint64_t log_offset = 0;
+    if (!m_snapshot_path.empty()) {
+        try {
+            if (auto info = UserSnapshot::load(m_snapshot_path, m_log.size_on_disk(), load)) {
+                log_offset = info->log_offset;
+                m_snapshot_offset = info->log_offset;
+                m_recovery.snapshot_records = info->records;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "⚠️ Snapshot ignorado: " << e.what() << std::endl;
+        }
+    }
+    m_recovery.snapshot_seconds = seconds_since(start);
+
+    // 2. Cola del log posterior al snapshot
+    const auto log_start = std::chrono::steady_clock::now();
+    UserLog::ReplayStats replayed = m_log.replay(log_offset, load);
+    m_recovery.log_records = replayed.records;
+    m_recovery.log_bytes = replayed.bytes;
+    m_recovery.log_seconds = seconds_since(log_start);
+    m_recovery.seconds = seconds_since(start);
+}
+
+LoggedUserStore::~LoggedUserStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_thread_mutex);
+        m_stopping = true;
+    }
+    m_stop_cv.notify_all();
+    if (m_snapshot_thread.joinable()) {
+        m_snapshot_thread.join();
+    }
+}
+
+std::optional<User> LoggedUserStore::find_by_username(std::string_view username) const {
+    return m_memory.find_by_username(username);
+}
+
+std::optional<User> LoggedUserStore::find_by_id(int id) const {
+    return m_memory.find_by_id(id);
+}
+
+bool LoggedUserStore::insert_if_absent(const User& user) {
+    return insert_batch({user}).front();
+}
+
+// Write-ahead: el nombre se reserva, el lote va al log y sólo tras el fsync
+// los usuarios se hacen visibles. Si el append falla, se liberan las
+// reservas y el error llega al handler sin dejar rastro en memoria.
+std::vector<bool> LoggedUserStore::insert_batch(const std::vector<User>& users) {
+    std::vector<bool> inserted;
+    inserted.reserve(users.size());
+    std::vector<User> accepted;
+    accepted.reserve(users.size());
+
+    for (const auto& user : users) {
+        const bool ok = m_memory.reserve_username(user.username);
+        inserted.push_back(ok);
+        if (ok) {
+            accepted.push_back(user);
+        }
+    }
+
+    // Compartido con otros commits; write_snapshot() lo toma en exclusiva
+    std::shared_lock<std::shared_mutex> commit(m_commit_mutex);
+    try {
+        m_log.append(accepted);
+    } catch (...) {
+        for (const auto& user : accepted) {
+            m_memory.release_username(user.username);
+        }
+        throw;
+    }
+    for (const auto& user : accepted) {
+        m_memory.publish(user);
+    }
+    return inserted;
+}
+
+std::vector<User> LoggedUserStore::page(int after_id, std::size_t limit) const {
+    return m_memory.page(after_id, limit);
+}
+
+void LoggedUserStore::for_each(const std::function<void(const User&)>& fn) const {
+    m_memory.for_each(fn);
+}
+
+std::size_t LoggedUserStore::size() const {
+    return m_memory.size();
+}
+
+int LoggedUserStore::max_id() const {
+    return m_memory.max_id();
+}
+
+UserSnapshot::Info LoggedUserStore::write_snapshot() {
+    std::lock_guard<std::mutex> lock(m_snapshot_mutex);
+
+    // El offset se toma antes de recorrer la memoria y sin commits a medias
+    // (entre append y publish): todo lo que hay en el log hasta aquí ya es
+    // visible en memoria y entra en el snapshot
+    std::uint64_t offset;
+    {
+        std::unique_lock<std::shared_mutex> commit(m_commit_mutex);
+        offset = m_log.end_offset();
+    }
+    UserSnapshot::Info info = UserSnapshot::write(m_snapshot_path, m_memory, offset);
+    m_snapshot_offset = offset;
+    return info;
+}
+
+void LoggedUserStore::start_snapshots(std::chrono::seconds interval) {
+    if (m_snapshot_path.empty() || m_snapshot_thread.joinable()) {
+        return;
+    }
+    m_snapshot_thread = std::thread([this, interval] { snapshot_loop(interval); });
+}
+
+void LoggedUserStore::snapshot_loop(std::chrono::seconds interval) {
+    std::unique_lock<std::mutex> lock(m_thread_mutex);
+    while (!m_stop_cv.wait_for(lock, interval, [this] { return m_stopping; })) {
+        lock.unlock();
+        try {
+            bool grew;
+            {
+                std::lock_guard<std::mutex> snapshot_lock(m_snapshot_mutex);
+                grew = m_log.end_offset() > m_snapshot_offset;
+            }
+            if (grew) {
+                const auto start = std::chrono::steady_clock::now();
+                UserSnapshot::Info info = write_snapshot();
+                std::cout << "📸 Snapshot: " << info.records << " usuarios en " << seconds_since(start) << " s"
+                          << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Error escribiendo snapshot: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "memory_user_store.h"
+#include "user_log.h"
+#include "user_snapshot.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+// Motor en memoria con durabilidad por write-ahead log y snapshots.
+//
+// Las lecturas van directas al MemoryUserStore; cada alta aceptada se
+// escribe en el UserLog y sólo después se hace visible en memoria. Con el GroupCommitter delante,
+// insert_batch agrupa un lote entero en un único write + fsync.
+// Al construirse carga el último snapshot (si hay) y reproduce sólo la cola
+// del log posterior a él. Los snapshots se escriben desde un hilo de fondo.
+class LoggedUserStore : public UserStore {
+public:
+    struct RecoveryStats {
+        std::uint64_t snapshot_records = 0;
+        double snapshot_seconds = 0;
+        std::uint64_t log_records = 0;
+        std::uint64_t log_bytes = 0;
+        double log_seconds = 0;
+        double seconds = 0;  // total
+    };
+
+    // snapshot_path vacío desactiva los snapshots
+    LoggedUserStore(const std::string& log_path, const std::string& snapshot_path, unsigned replay_threads);
+    ~LoggedUserStore() override;
+
+    const char* name() const override { return "memory+log"; }
+
+    std::optional<User> find_by_username(std::string_view username) const override;
+    std::optional<User> find_by_id(int id) const override;
+    bool insert_if_absent(const User& user) override;
+    std::vector<bool> insert_batch(const std::vector<User>& users) override;
+    std::vector<User> page(int after_id, std::size_t limit) const override;
+    void for_each(const std::function<void(const User&)>& fn) const override;
+    std::size_t size() const override;
+    int max_id() const override;
+    bool durable() const override { return true; }
+
+    // Escribe un snapshot ahora (lo usa el hilo de fondo)
+    UserSnapshot::Info write_snapshot();
+
+    // Lanza el hilo que escribe un snapshot cada `interval` si el log creció
+    void start_snapshots(std::chrono::seconds interval);
+
+    const RecoveryStats& recovery() const { return m_recovery; }
+    const MemoryUserStore& memory() const { return m_memory; }
+
+private:
+    void snapshot_loop(std::chrono::seconds interval);
+
+    MemoryUserStore m_memory;
+    UserLog m_log;
+    const std::string m_snapshot_path;
+    RecoveryStats m_recovery;
+
+    std::shared_mutex m_commit_mutex;  // append + publish frente al offset del snapshot
+    std::mutex m_snapshot_mutex;       // un snapshot a la vez
+    std::uint64_t m_snapshot_offset = 0;
+
+    std::mutex m_thread_mutex;
+    std::condition_variable m_stop_cv;
+    bool m_stopping = false;
+    std::thread m_snapshot_thread;
+};
@@ -1,208 +1,604 @@
 #include <crow.h>
-#include <jwt-cpp/jwt.h>
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <vector>
 #include <string>
+#include <memory>
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#include "claims_response.h"
+#include "compact_user_store.h"
+#include "credentials_request.h"
+#include "error_responses.h"
+#include "group_committer.h"
+#include "id_allocator.h"
+#include "key_ring.h"
+#include "logged_user_store.h"
+#include "mapped_user_store.h"
+#include "memory_user_store.h"
+#include "pg_user_store.h"
+#include "response_bodies.h"
+#include "revocation_list.h"
+#include "session_store.h"
+#include "token_batch.h"
+#include "token_service.h"
+#include "token_verifier.h"
+#include "user_list_stream.h"
+#include "user_page.h"
+#include "worker_pool.h"
 
 using namespace std;
 using json = nlohmann::json;
 
-// Estructura simple para almacenar usuarios en memoria
-struct User {
-    string username;
-    string password;  // En la vida real, esto debería estar hasheado
-    int id;
-};
+// "Base de datos": cualquier motor que implemente UserStore
+// (el de memoria se pierde al reiniciar)
+unique_ptr<UserStore> users_db;
+IdAllocator user_ids;
+
+// Emisor de tokens compartido por /register y /login (dueño de la clave)
+unique_ptr<TokenService> token_service;
+
+// Tokens revocados por /logout (por jti, hasta su expiración)
+unique_ptr<RevocationList> revoked_tokens;
+
+// Sesiones de /refresh: el token de acceso dura poco y se renueva sin password
+unique_ptr<SessionStore> sessions;
+
+// Validación de tokens con caché de tokens ya verificados
+unique_ptr<TokenVerifier> token_verifier;
+
+// Hilos que reparten los lotes de /verify/batch entre núcleos
+unique_ptr<WorkerPool> batch_pool;
+
+// Write-behind de registros; sólo existe si el motor es durable
+unique_ptr<GroupCommitter> register_committer;
 
-// "Base de datos" en memoria (se pierde al reiniciar)
-vector<User> users_db;
-int next_user_id = 1;
+// Ficheros temporales con el cuerpo de /users, que Crow envía por trozos (con cupo)
+unique_ptr<UserListSpool> users_spool;
+
+// Lector del body de /register y /login, uno por hilo (reutiliza sus buffers)
+thread_local CredentialsParser credentials_parser;
+
+// Lee una variable de entorno numérica, con valor por defecto
+size_t env_size(const char* name, size_t fallback) {
+    const char* value = getenv(name);
+    return value ? stoul(value) : fallback;
+}
+
+// Error de forma fija: el cuerpo ya está serializado (error_responses.h) y
+// no se escribe JSON. Queda una copia de ~60 bytes por rechazo porque
+// crow::response guarda el cuerpo en su propio std::string (Crow 1.x no
+// admite cuerpos prestados) y compone las cabeceras al enviar cada respuesta,
+// así que tampoco hay un bloque de cabeceras que reutilizar.
+crow::response api_error_response(ApiError error) {
+    const ErrorBody& e = api_error(error);
+    return crow::response(e.status(), string(e.body()));
+}
+
+// GET /users. Sin parámetros, el listado entero página a página del motor
+// (user_list_stream.h), volcado a un fichero del spool que queda en `listing`;
+// la memoria no depende del número de usuarios.
+// ⚠️ NO enviamos la password por seguridad
+crow::response users_response(const crow::request& req, size_t max_page, UserListSpool::Entry& listing) {
+    const char* limit_param = req.url_params.get("limit");
+    const char* cursor_param = req.url_params.get("cursor");
+    try {
+        if (!limit_param && !cursor_param) {
+            listing = users_spool->write(*users_db);
+            if (!listing && listing.too_large()) {
+                // No cabe en USERS_SPOOL_MAX_MB ni con el spool libre: reintentar no sirve
+                return api_error_response(ApiError::UsersListTooLarge);
+            }
+            if (!listing) {
+                crow::response res = api_error_response(ApiError::UsersListBusy);
+                res.set_header("Retry-After", "1");
+                return res;
+            }
+            crow::response res;
+            res.set_static_file_info(listing.path());
+            return res;
+        }
+        
+        // Paginación por cursor (user_page.h); limit por encima de USERS_PAGE_MAX se recorta
+        size_t limit = min<size_t>(100, max_page);
+        if (limit_param) {
+            const char* end = limit_param + strlen(limit_param);
+            const auto parsed = from_chars(limit_param, end, limit);
+            if (parsed.ec != errc() || parsed.ptr != end || limit == 0) {
+                return api_error_response(ApiError::InvalidPageLimit);
+            }
+            limit = min(limit, max_page);
+        }
+        int after_id = 0;
+        if (cursor_param && !decode_user_cursor(cursor_param, after_id)) {
+            return api_error_response(ApiError::InvalidCursor);
+        }
+        return crow::response(200, user_page_response(*users_db, after_id, limit));
+    } catch (const exception& e) {
+        cout << "❌ Error al listar usuarios: " << e.what() << endl;
+        return api_error_response(ApiError::InternalError);
+    }
+}
+
+// Error de JwtAuth para cada resultado de la verificación (mismos textos que describe())
+ApiError token_error(TokenVerifier::Status status) {
+    switch (status) {
+        case TokenVerifier::Status::BadSignature: return ApiError::TokenBadSignature;
+        case TokenVerifier::Status::Expired: return ApiError::TokenExpired;
+        case TokenVerifier::Status::Revoked: return ApiError::TokenRevoked;
+        case TokenVerifier::Status::UnknownKey: return ApiError::TokenUnknownKey;
+        case TokenVerifier::Status::Valid:
+        case TokenVerifier::Status::Malformed: break;
+    }
+    return ApiError::TokenMalformed;
+}
+
+// Elige el motor según el entorno: DATABASE_URL activa PostgreSQL,
+// USER_LOG_PATH el motor en memoria con write-ahead log y, junto con
+// USER_TABLE_PATH, la tabla proyectada con mmap (ver tools/user_table_build)
+unique_ptr<UserStore> make_user_store() {
+    if (const char* url = getenv("DATABASE_URL")) {
+        // Un hilo de Crow por núcleo: con el mismo número de conexiones no hay espera
+        size_t pool_size = max(1u, thread::hardware_concurrency());
+        if (const char* size = getenv("DB_POOL_SIZE")) {
+            pool_size = stoul(size);
+        }
+        cout << "🐘 Usando PostgreSQL (" << pool_size << " conexiones)" << endl;
+        return make_unique<PgUserStore>(url, pool_size);
+    }
+    const char* table = getenv("USER_TABLE_PATH");
+    if (const char* path = getenv("USER_LOG_PATH"); path && table) {
+        auto store = make_unique<MappedUserStore>(table, path, max(1u, thread::hardware_concurrency()));
+        cout << "🗺️ Tabla " << table << ": " << store->table().size() << " usuarios proyectados + "
+             << store->replayed_records() << " del log" << endl;
+        return store;
+    }
+    if (const char* path = getenv("USER_LOG_PATH")) {
+        const char* snapshot = getenv("SNAPSHOT_PATH");
+        auto store = make_unique<LoggedUserStore>(path, snapshot ? snapshot : string(path) + ".snap",
+                                                  max(1u, thread::hardware_concurrency()));
+        const auto& r = store->recovery();
+        cout << "📜 Recuperación: snapshot " << r.snapshot_records << " usuarios en " << r.snapshot_seconds
+             << " s + log " << r.log_records << " usuarios (" << r.log_bytes / 1024 << " KiB) en "
+             << r.log_seconds << " s" << endl;
+        store->start_snapshots(chrono::seconds(env_size("SNAPSHOT_INTERVAL_S", 300)));
+        return store;
+    }
+    if (const char* kind = getenv("USER_STORE"); kind && string(kind) == "compact") {
+        cout << "💾 Usando almacenamiento en memoria compacto (columnas + arena)" << endl;
+        return make_unique<CompactUserStore>();
+    }
+    cout << "💾 Usando almacenamiento en memoria" << endl;
+    return make_unique<MemoryUserStore>();
+}
+
+// Claves de firma: JWT_KEYS_FILE ("<kid> [alg] <secreto o PEM>" por línea, la
+// última es la activa) o, si no está definido, el secreto de siempre con kid "default"
+vector<KeyRing::Spec> load_signing_keys() {
+    if (const char* path = getenv("JWT_KEYS_FILE")) {
+        return KeyRing::parse_file(path);
+    }
+    return {{KeyRing::kDefaultKid, "mi_secreto_super_seguro"}};
+}
+
+// Middleware JWT: exige "Authorization: Bearer <token>" en las rutas que lo
+// declaran con CROW_MIDDLEWARES y deja los claims en el contexto
+struct JwtAuth : crow::ILocalMiddleware {
+    struct context {
+        shared_ptr<const TokenClaims> claims;
+    };
+
+    const TokenVerifier* verifier = nullptr;
+
+    void before_handle(crow::request& req, crow::response& res, context& ctx) {
+        const string& header = req.get_header_value("Authorization");
+        const string_view prefix = "Bearer ";
+        
+        TokenVerifier::Status status = TokenVerifier::Status::Malformed;
+        if (header.size() > prefix.size() && string_view(header).substr(0, prefix.size()) == prefix) {
+            auto result = verifier->verify(string_view(header).substr(prefix.size()));
+            if (result) {
+                ctx.claims = move(result.claims);
+                return;
+            }
+            status = result.status;
+        }
+        
+        const ErrorBody& error = api_error(header.empty() ? ApiError::TokenRequired : token_error(status));
+        res.code = error.status();
+        res.add_header("WWW-Authenticate", "Bearer");
+        res.body.assign(error.body());
+        res.end();
+    }
+
+    void after_handle(crow::request&, crow::response&, context&) {}
+};
 
 int main() {
-    crow::SimpleApp app;
+    const auto boot_start = chrono::steady_clock::now();
+    users_db = make_user_store();
+    token_service = make_unique<TokenService>(load_signing_keys(),
+                                              chrono::seconds(env_size("ACCESS_TOKEN_TTL_S", 900)));
+    const auto& signing_keys = token_service->keys().current();
+    cout << "🔑 " << signing_keys.keys.size() << " claves de firma, activa: " << signing_keys.active->kid << " ("
+         << signing_keys.active->signer->alg() << ")" << endl;
+    sessions = make_unique<SessionStore>(chrono::seconds(env_size("REFRESH_TOKEN_TTL_S", 30 * 86400)));
+    sessions->start_sweeper(chrono::seconds(env_size("SESSION_SWEEP_S", 1)));
+    cout << "⏱️ Tokens de acceso: " << token_service->lifetime().count() << " s, sesiones de refresco: "
+         << sessions->lifetime().count() << " s" << endl;
+    revoked_tokens = make_unique<RevocationList>();
+    revoked_tokens->start_sweeper(chrono::seconds(env_size("REVOCATION_SWEEP_S", 60)));
+    token_verifier = make_unique<TokenVerifier>(token_service->keys(), env_size("JWT_CACHE_SIZE", 1 << 16),
+                                                revoked_tokens.get());
+    batch_pool = make_unique<WorkerPool>(env_size("VERIFY_BATCH_THREADS", max(1u, thread::hardware_concurrency())));
+    const size_t max_batch = env_size("VERIFY_BATCH_MAX", 10000);
+    // El límite no cambia en marcha: su 413 se serializa una vez
+    const string batch_too_large = error_response("Como máximo " + to_string(max_batch) + " tokens por lote");
+    const char* spool_dir = getenv("USERS_SPOOL_DIR");
+    users_spool = make_unique<UserListSpool>(
+        spool_dir ? string(spool_dir) : (filesystem::temp_directory_path() / "servidor-users").string(),
+        env_size("USERS_SPOOL_MAX", 4), static_cast<uint64_t>(env_size("USERS_SPOOL_MAX_MB", 1024)) << 20);
+    const size_t max_page = max<size_t>(1, env_size("USERS_PAGE_MAX", 1000));
+    user_ids.advance_to(users_db->max_id() + 1);
+    
+    if (users_db->durable()) {
+        GroupCommitter::Config config;
+        config.max_batch = env_size("COMMIT_BATCH_SIZE", config.max_batch);
+        config.max_delay = chrono::milliseconds(env_size("COMMIT_MAX_DELAY_MS", 2));
+        register_committer = make_unique<GroupCommitter>(*users_db, config);
+        cout << "📦 Group commit: hasta " << config.max_batch << " registros o "
+             << chrono::duration_cast<chrono::milliseconds>(config.max_delay).count() << " ms por lote" << endl;
+    }
+    
+    crow::App<JwtAuth> app;
+    app.get_middleware<JwtAuth>().verifier = token_verifier.get();
     
     // Endpoint de registro - POST /register
     CROW_ROUTE(app, "/register").methods("POST"_method)([](const crow::request& req) {
         cout << "📝 Solicitud de registro recibida" << endl;
         
         try {
-            // 1. Parsear el JSON del body
-            json request_data = json::parse(req.body);
+            // 1. Leer username y password del body (vistas sobre él, sin DOM)
+            Credentials credentials;
+            const auto status = credentials_parser.parse(req.body, credentials);
+            if (status == CredentialsParser::Status::Malformed || status == CredentialsParser::Status::NotString) {
+                cout << "❌ Error de JSON: body inválido" << endl;
+                return api_error_response(ApiError::InvalidJson);
+            }
             
             // 2. Verificar que tenga los campos necesarios
-            if (!request_data.contains("username") || !request_data.contains("password")) {
-                json error_response = {
-                    {"success", false},
-                    {"error", "Se requieren los campos: username y password"}
-                };
-                return crow::response(400, error_response.dump());
+            if (status == CredentialsParser::Status::Missing) {
+                return api_error_response(ApiError::RegisterFieldsRequired);
             }
             
-            string username = request_data["username"];
-            string password = request_data["password"];
+            const string_view username = credentials.username;
+            const string_view password = credentials.password;
             
             cout << "🔍 Intentando registrar usuario: " << username << endl;
             
             // 3. Verificar que el username no esté vacío
             if (username.empty() || password.empty()) {
-                json error_response = {
-                    {"success", false},
-                    {"error", "Username y password no pueden estar vacíos"}
-                };
-                return crow::response(400, error_response.dump());
-            }
-            
-            // 4. Verificar si el usuario ya existe
-            for (const auto& user : users_db) {
-                if (user.username == username) {
-                    json error_response = {
-                        {"success", false},
-                        {"error", "El usuario ya existe"}
-                    };
-                    return crow::response(409, error_response.dump()); // 409 = Conflict
-                }
+                return api_error_response(ApiError::EmptyCredentials);
+            }
+            if (!users_db->accepts(username, password)) {
+                return api_error_response(ApiError::CredentialsTooLong);
             }
             
-            // 5. "Crear" el usuario (guardar en memoria)
+            // 4. Rechazar pronto si el usuario ya existe (no consume id)
+            if (users_db->find_by_username(username)) {
+                return api_error_response(ApiError::UserExists); // 409 = Conflict
+            }
+            
+            // 5. "Crear" el usuario. La inserción es atómica: si otro hilo registró
+            //    el mismo username entre medias, también es 409. Con un motor durable
+            //    se espera a que el lote del group commit esté confirmado.
             User new_user = {
-                username,
-                password,  // ⚠️ En producción: hashear con bcrypt
-                next_user_id++
+                string(username),
+                string(password),  // ⚠️ En producción: hashear con bcrypt
+                user_ids.next()
             };
-            users_db.push_back(new_user);
+            bool inserted = register_committer
+                ? register_committer->submit(new_user).get()
+                : users_db->insert_if_absent(new_user);
+            if (!inserted) {
+                return api_error_response(ApiError::UserExists); // 409 = Conflict
+            }
             
             cout << "✅ Usuario creado: " << username << " con ID: " << new_user.id << endl;
             
-            // 6. Generar JWT token para el usuario recién creado
-            auto token = jwt::create()
-                .set_issuer("auth.transmi")
-                .set_type("JWS")
-                .set_payload_claim("user_id", jwt::claim(to_string(new_user.id)))
-                .set_payload_claim("username", jwt::claim(username))
-                .set_expires_at(chrono::system_clock::now() + chrono::hours{24}) // Expira en 24 horas
-                .sign(jwt::algorithm::hs256{"mi_secreto_super_seguro"});
-            
-            // 7. Respuesta exitosa
-            json success_response = {
-                {"success", true},
-                {"message", "Usuario registrado exitosamente"},
-                {"user", {
-                    {"id", new_user.id},
-                    {"username", username}
-                }},
-                {"token", token},
-                {"expires_in", 86400} // 24 horas en segundos
-            };
+            // 6. Generar JWT token (corto) y sesión de refresco para el usuario recién creado
+            auto token = token_service->issue(new_user.id, username);
+            auto refresh_token = sessions->create(new_user.id, username);
             
-            return crow::response(201, success_response.dump()); // 201 = Created
-            
-        } catch (const json::exception& e) {
-            cout << "❌ Error de JSON: " << e.what() << endl;
-            json error_response = {
-                {"success", false},
-                {"error", "JSON inválido"}
-            };
-            return crow::response(400, error_response.dump());
+            // 7. Respuesta exitosa (201 = Created)
+            return crow::response(201, session_response("Usuario registrado exitosamente", new_user.id, username,
+                                                        token, refresh_token, token_service->lifetime()));
             
         } catch (const exception& e) {
             cout << "❌ Error interno: " << e.what() << endl;
-            json error_response = {
-                {"success", false},
-                {"error", "Error interno del servidor"}
-            };
-            return crow::response(500, error_response.dump());
+            return api_error_response(ApiError::InternalError);
         }
     });
     
     // Endpoint para ver usuarios registrados (solo para debug)
     CROW_ROUTE(app, "/users")
-    ([](const crow::request& req) {
+    ([max_page](const crow::request& req, crow::response& res) {
+        // El listado completo se envía dentro de res.end(); al salir, `listing` borra el fichero
+        UserListSpool::Entry listing;
+        res = users_response(req, max_page, listing);
+        res.end();
+    });
+    
+    // Estadísticas internas (caché JWT, group commit, ...)
+    CROW_ROUTE(app, "/stats")
+    ([]() {
+        json response = {
+            {"success", true},
+            {"store", users_db->name()}
+        };
+        
+        const auto& keys = token_service->keys().current();
+        response["signing_keys"] = {
+            {"active", keys.active->kid},
+            {"alg", keys.active->signer->alg()},
+            {"keys", keys.keys.size()},
+            {"version", keys.version}
+        };
+        
+        auto jwt = token_verifier->stats();
+        const auto lookups = jwt.hits + jwt.misses;
+        response["jwt_cache"] = {
+            {"capacity", jwt.capacity},
+            {"hits", jwt.hits},
+            {"thread_hits", jwt.thread_hits},
+            {"misses", jwt.misses},
+            {"rejected", jwt.rejected},
+            {"hit_rate", lookups ? double(jwt.hits) / lookups : 0.0},
+            {"hit_ns_avg", jwt.hits ? double(jwt.hit_ns_total) / jwt.hits : 0.0},
+            {"verify_us_avg", jwt.misses ? jwt.verify_ns_total / 1e3 / jwt.misses : 0.0}
+        };
+        
+        auto session_stats = sessions->stats();
+        response["sessions"] = {
+            {"live", session_stats.sessions},
+            {"memory_bytes", session_stats.memory_bytes},
+            {"created", session_stats.created},
+            {"refreshed", session_stats.refreshed},
+            {"rejected", session_stats.rejected},
+            {"expired", session_stats.expired},
+            {"sweep_us_avg", session_stats.sweeps ? session_stats.sweep_ns_total / 1e3 / session_stats.sweeps : 0.0},
+            {"sweep_ms_max", session_stats.sweep_ns_max / 1e6}
+        };
+        
+        auto revoked = revoked_tokens->stats();
+        response["revocations"] = {
+            {"entries", revoked.entries},
+            {"filter_bytes", revoked.filter_bytes},
+            {"filter_positives", revoked.filter_positives},
+            {"false_positives", revoked.false_positives}
+        };
+        
+        if (register_committer) {
+            auto stats = register_committer->stats();
+            const auto& config = register_committer->config();
+            response["group_commit"] = {
+                {"max_batch", config.max_batch},
+                {"max_delay_ms", chrono::duration<double, milli>(config.max_delay).count()},
+                {"commits", stats.commits},
+                {"records", stats.records},
+                {"records_per_commit", stats.commits ? double(stats.records) / stats.commits : 0.0},
+                {"max_records_per_commit", stats.max_records_per_commit},
+                {"commit_ms_avg", stats.commits ? stats.commit_ns_total / 1e6 / stats.commits : 0.0}
+            };
+        }
+        
+        return crow::response(200, response.dump());
+    });
+    
+    // Validación de token - GET /verify con "Authorization: Bearer <token>"
+    CROW_ROUTE(app, "/verify").CROW_MIDDLEWARES(app, JwtAuth)
+    ([&app](const crow::request& req) {
+        return crow::response(200, claims_response(*app.get_context<JwtAuth>(req).claims));
+    });
+    
+    // Identidad del usuario del token - GET /me. Sale entera de los claims: ni
+    // búsquedas en el motor de usuarios ni locks (caché de tokens del hilo).
+    CROW_ROUTE(app, "/me").CROW_MIDDLEWARES(app, JwtAuth)
+    ([&app](const crow::request& req) {
+        crow::response response(200, claims_response(*app.get_context<JwtAuth>(req).claims));
+        response.set_header("Content-Type", "application/json");
+        response.set_header("Cache-Control", "no-store");
+        return response;
+    });
+    
+    // Verificación por lotes - POST /verify/batch con {"tokens": ["...", ...]}:
+    // el gateway valida muchos tokens en una petición. Se reparte entre núcleos
+    // y usa la misma caché que /verify.
+    CROW_ROUTE(app, "/verify/batch").methods("POST"_method)
+    ([max_batch, &batch_too_large](const crow::request& req) {
+        vector<string_view> tokens;
+        json request_data;
+        if (!parse_token_batch(req.body, tokens)) {
+            // Forma poco habitual (escapes, otras claves, ...): la lee nlohmann
+            try {
+                request_data = json::parse(req.body);
+            } catch (const json::exception& e) {
+                return api_error_response(ApiError::InvalidJson);
+            }
+            
+            const bool is_array = request_data.contains("tokens") && request_data["tokens"].is_array();
+            if (is_array) {
+                for (const auto& token : request_data["tokens"]) {
+                    if (!token.is_string()) {
+                        tokens.clear();
+                        break;
+                    }
+                    tokens.push_back(token.get_ref<const string&>());
+                }
+            }
+            if (!is_array || tokens.size() != request_data["tokens"].size()) {
+                return api_error_response(ApiError::TokensRequired);
+            }
+        }
+        
+        if (tokens.size() > max_batch) {
+            return crow::response(413, batch_too_large); // 413 = Payload Too Large
+        }
+        
+        crow::response response(200, verify_token_batch(*token_verifier, *batch_pool, tokens));
+        response.set_header("Content-Type", "application/json");
+        return response;
+    });
+    
+    // Cierre de sesión - POST /logout: revoca el token hasta su expiración
+    CROW_ROUTE(app, "/logout").methods("POST"_method).CROW_MIDDLEWARES(app, JwtAuth)
+    ([&app](const crow::request& req) {
+        const auto& claims = app.get_context<JwtAuth>(req).claims;
+        if (claims->jti.empty()) {
+            return api_error_response(ApiError::TokenNotRevocable);
+        }
+        
+        revoked_tokens->revoke(claims->jti, claims->expires_at);
+        
+        // Si llega el refresh token en el body, también se cierra la sesión de refresco
+        if (!req.body.empty()) {
+            json request_data = json::parse(req.body, nullptr, false);
+            if (request_data.is_object() && request_data.contains("refresh_token") &&
+                request_data["refresh_token"].is_string()) {
+                sessions->revoke(request_data["refresh_token"].get<string>());
+            }
+        }
+        cout << "👋 Sesión cerrada: " << claims->username << endl;
+        
         json response = {
             {"success", true},
-            {"users", json::array()}
+            {"message", "Sesión cerrada"}
         };
+        return crow::response(200, response.dump());
+    });
+    
+    // Claves públicas para que otros servicios verifiquen los tokens (ES256/EdDSA).
+    // El cuerpo se serializa una vez por juego de claves, no por petición.
+    CROW_ROUTE(app, "/.well-known/jwks.json")
+    ([]() {
+        crow::response response(200, token_service->keys().current().jwks);
+        response.set_header("Content-Type", "application/json");
+        response.set_header("Cache-Control", "public, max-age=300");
+        return response;
+    });
+    
+    // Recarga de claves de firma sin reiniciar - POST /admin/keys/reload (sólo desde localhost)
+    CROW_ROUTE(app, "/admin/keys/reload").methods("POST"_method)
+    ([](const crow::request& req) {
+        if (req.remote_ip_address != "127.0.0.1" && req.remote_ip_address != "::1") {
+            return api_error_response(ApiError::LocalhostOnly);
+        }
+        if (!getenv("JWT_KEYS_FILE")) {
+            return api_error_response(ApiError::KeysFileMissing);
+        }
         
-        for (const auto& user : users_db) {
-            response["users"].push_back({
-                {"id", user.id},
-                {"username", user.username}
-                // ⚠️ NO enviamos la password por seguridad
-            });
+        try {
+            token_service->keys().reload(load_signing_keys());
+        } catch (const exception& e) {
+            // Se conservan las claves actuales
+            cout << "❌ Error recargando claves: " << e.what() << endl;
+            return crow::response(400, error_response(e.what()));
         }
         
+        const auto& keys = token_service->keys().current();
+        cout << "🔑 Claves recargadas: " << keys.keys.size() << ", activa: " << keys.active->kid << " ("
+             << keys.active->signer->alg() << ")" << endl;
+        json response = {
+            {"success", true},
+            {"keys", keys.keys.size()},
+            {"active", keys.active->kid},
+            {"version", keys.version}
+        };
         return crow::response(200, response.dump());
     });
     
+    // Renovación del token de acceso - POST /refresh con {"refresh_token": "..."}.
+    // Una búsqueda O(1) en la tabla de sesiones, sin comprobar la password; el
+    // refresh token se rota en cada uso.
+    CROW_ROUTE(app, "/refresh").methods("POST"_method)
+    ([](const crow::request& req) {
+        try {
+            json request_data = json::parse(req.body);
+            
+            if (!request_data.contains("refresh_token") || !request_data["refresh_token"].is_string()) {
+                return api_error_response(ApiError::RefreshTokenRequired);
+            }
+            
+            auto renewal = sessions->refresh(request_data["refresh_token"].get<string>());
+            if (!renewal) {
+                return api_error_response(ApiError::RefreshTokenInvalid);
+            }
+            
+            const auto token = token_service->issue(renewal->user_id, renewal->username);
+            return crow::response(200, session_response({}, renewal->user_id, renewal->username, token,
+                                                        renewal->refresh_token, token_service->lifetime()));
+            
+        } catch (const json::exception& e) {
+            return api_error_response(ApiError::InvalidJson);
+            
+        } catch (const exception& e) {
+            cout << "❌ Error interno: " << e.what() << endl;
+            return api_error_response(ApiError::InternalError);
+        }
+    });
+    
     // Endpoint de login simple
     CROW_ROUTE(app, "/login").methods("POST"_method)
     ([](const crow::request& req) {
         cout << "🔑 Solicitud de login recibida" << endl;
         
         try {
-            json request_data = json::parse(req.body);
+            Credentials credentials;
+            const auto status = credentials_parser.parse(req.body, credentials);
+            if (status == CredentialsParser::Status::Malformed || status == CredentialsParser::Status::NotString) {
+                // JSON inválido: 500, como cuando json::parse lanzaba al catch genérico
+                return api_error_response(ApiError::InternalError);
+            }
             
-            if (!request_data.contains("username") || !request_data.contains("password")) {
-                json error_response = {
-                    {"success", false},
-                    {"error", "Se requieren username y password"}
-                };
-                return crow::response(400, error_response.dump());
+            if (status == CredentialsParser::Status::Missing) {
+                return api_error_response(ApiError::LoginFieldsRequired);
             }
             
-            string username = request_data["username"];
-            string password = request_data["password"];
+            const string_view username = credentials.username;
+            const string_view password = credentials.password;
             
             // Buscar usuario
-            for (const auto& user : users_db) {
-                if (user.username == username && user.password == password) {
-                    // ✅ Usuario encontrado, generar token
-                    auto token = jwt::create()
-                        .set_issuer("auth.transmi")
-                        .set_type("JWS")
-                        .set_payload_claim("user_id", jwt::claim(to_string(user.id)))
-                        .set_payload_claim("username", jwt::claim(username))
-                        .set_expires_at(chrono::system_clock::now() + chrono::hours{24})
-                        .sign(jwt::algorithm::hs256{"mi_secreto_super_seguro"});
-                    
-                    json success_response = {
-                        {"success", true},
-                        {"message", "Login exitoso"},
-                        {"user", {
-                            {"id", user.id},
-                            {"username", username}
-                        }},
-                        {"token", token}
-                    };
-                    
-                    return crow::response(200, success_response.dump());
-                }
+            auto user = users_db->find_by_username(username);
+            if (user && user->password == password) {
+                // ✅ Usuario encontrado, generar token
+                auto token = token_service->issue(user->id, username);
+                auto refresh_token = sessions->create(user->id, username);
+                
+                return crow::response(200, session_response("Login exitoso", user->id, user->username, token,
+                                                            refresh_token, token_service->lifetime()));
             }
             
             // ❌ Usuario no encontrado o password incorrecta
-            json error_response = {
-                {"success", false},
-                {"error", "Credenciales inválidas"}
-            };
-            return crow::response(401, error_response.dump()); // 401 = Unauthorized
+            return api_error_response(ApiError::InvalidCredentials); // 401 = Unauthorized
             
         } catch (const exception& e) {
-            json error_response = {
-                {"success", false},
-                {"error", "Error interno del servidor"}
-            };
-            return crow::response(500, error_response.dump());
+            return api_error_response(ApiError::InternalError);
         }
     });
     
-    // Iniciar servidor
-    cout << "🚀 Servidor iniciando en puerto 8080..." << endl;
-    cout << "📍 Endpoints disponibles:" << endl;
-    cout << "   POST /register - Registrar usuario" << endl;
-    cout << "   POST /login    - Iniciar sesión" << endl;
-    cout << "   GET  /users    - Ver usuarios (debug)" << endl;
+    // Iniciar servidor: informe de arranque con lo que tardó la recuperación
+    const auto boot_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - boot_start).count();
+    cout << "🚀 Servidor listo en " << boot_ms << " ms: " << users_db->size() << " usuarios ("
+         << users_db->name() << "), puerto 8080" << endl;
     
-    app.port(8080).multithreaded().run();
+    // Con group commit los hilos esperan al lote: SERVER_THREADS permite tener más
+    auto threads = env_size("SERVER_THREADS", max(1u, thread::hardware_concurrency()));
+    app.port(8080).concurrency(static_cast<uint16_t>(threads)).run();
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "mapped_file.h"
+
+#include <cerrno>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::system_error(ENOENT, std::generic_category(), "open " + path);
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    m_file = file;
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0) {
+        return;
+    }
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (m_data == nullptr) {
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+        }
+        CloseHandle(file);
+        throw std::system_error(EIO, std::generic_category(), "mmap " + path);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "stat " + path);
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size > 0) {
+        void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap " + path);
+        }
+        // Los lookups saltan por el fichero: sin lectura anticipada
+        ::madvise(data, m_size, MADV_RANDOM);
+        m_data = static_cast<const char*>(data);
+    }
+    ::close(fd);  // el mapeo sigue vivo sin el descriptor
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+#else
+    if (m_data) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+}
@@ -0,0 +1,102 @@
+#include "mapped_user_store.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+MappedUserStore::MappedUserStore(const std::string& table_path, const std::string& log_path,
+                                 unsigned replay_threads)
+    : m_table(table_path), m_log(log_path) {
+    UserLog::ReplayStats replayed = m_log.replay(m_table.log_offset(), [&](std::vector<User>& batch) {
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                   [&](const User& user) { return m_table.find(user.username) != nullptr; }),
+                    batch.end());
+        m_overlay.bulk_load(batch, replay_threads);
+    });
+    m_replayed = replayed.records;
+}
+
+std::optional<User> MappedUserStore::find_by_username(std::string_view username) const {
+    if (const UserTableRecord* record = m_table.find(username)) {
+        return UserTable::to_user(*record);
+    }
+    return m_overlay.find_by_username(username);
+}
+
+std::optional<User> MappedUserStore::find_by_id(int id) const {
+    if (const UserTableRecord* record = m_table.find(id)) {
+        return UserTable::to_user(*record);
+    }
+    return m_overlay.find_by_id(id);
+}
+
+bool MappedUserStore::insert_if_absent(const User& user) {
+    return insert_batch({user}).front();
+}
+
+// Como LoggedUserStore: reserva, log y después visible (ver insert_batch allí).
+// Lo que no cabe en la tabla no llega al log: /register lo filtra con accepts().
+std::vector<bool> MappedUserStore::insert_batch(const std::vector<User>& users) {
+    for (const auto& user : users) {
+        if (!UserTable::fits(user)) {
+            throw std::length_error("MappedUserStore: el usuario " + user.username +
+                                    " no cabe en los huecos fijos de la tabla");
+        }
+    }
+    std::vector<bool> inserted;
+    inserted.reserve(users.size());
+    std::vector<User> accepted;
+
+    for (const auto& user : users) {
+        const bool ok = m_table.find(user.username) == nullptr && m_overlay.reserve_username(user.username);
+        inserted.push_back(ok);
+        if (ok) {
+            accepted.push_back(user);
+        }
+    }
+    try {
+        m_log.append(accepted);
+    } catch (...) {
+        for (const auto& user : accepted) {
+            m_overlay.release_username(user.username);
+        }
+        throw;
+    }
+    for (const auto& user : accepted) {
+        m_overlay.publish(user);
+    }
+    return inserted;
+}
+
+std::vector<User> MappedUserStore::page(int after_id, std::size_t limit) const {
+    // Mezcla ordenada de la tabla (ya ordenada por id) y la memoria
+    std::vector<User> overlay = m_overlay.page(after_id, limit);
+    std::vector<User> result;
+    result.reserve(limit);
+
+    std::size_t t = m_table.upper_bound(after_id);
+    std::size_t o = 0;
+    while (result.size() < limit && (t < m_table.size() || o < overlay.size())) {
+        const bool take_table = o == overlay.size() || (t < m_table.size() && m_table.record(t).id < overlay[o].id);
+        if (take_table) {
+            result.push_back(UserTable::to_user(m_table.record(t++)));
+        } else {
+            result.push_back(std::move(overlay[o++]));
+        }
+    }
+    return result;
+}
+
+void MappedUserStore::for_each(const std::function<void(const User&)>& fn) const {
+    for (std::size_t i = 0; i < m_table.size(); ++i) {
+        fn(UserTable::to_user(m_table.record(i)));
+    }
+    m_overlay.for_each(fn);
+}
+
+std::size_t MappedUserStore::size() const {
+    return m_table.size() + m_overlay.size();
+}
+
+int MappedUserStore::max_id() const {
+    return std::max(m_table.max_id(), m_overlay.max_id());
+}
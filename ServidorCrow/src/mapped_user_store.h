@@ -0,0 +1,46 @@
+#pragma once
+
+#include "memory_user_store.h"
+#include "user_log.h"
+#include "user_table.h"
+
+#include <string>
+
+// Motor que sirve los /login directamente desde una UserTable proyectada
+// con mmap: arrancar cuesta lo que abrir el fichero y las páginas se cargan
+// al primer acceso.
+//
+// La tabla es inmutable; las altas posteriores van a un MemoryUserStore en
+// memoria respaldado por el mismo UserLog del que se construyó la tabla.
+// Al arrancar sólo se reproduce el log a partir de table.log_offset().
+// Para incorporar esas altas a la tabla, reconstruirla con user_table_build;
+// por eso sólo se admiten altas que caben en los huecos fijos de la tabla
+// (accepts()), o la reconstrucción fallaría desde ese alta en adelante.
+class MappedUserStore : public UserStore {
+public:
+    MappedUserStore(const std::string& table_path, const std::string& log_path, unsigned replay_threads);
+
+    const char* name() const override { return "mmap+log"; }
+
+    std::optional<User> find_by_username(std::string_view username) const override;
+    std::optional<User> find_by_id(int id) const override;
+    bool insert_if_absent(const User& user) override;
+    std::vector<bool> insert_batch(const std::vector<User>& users) override;
+    std::vector<User> page(int after_id, std::size_t limit) const override;
+    void for_each(const std::function<void(const User&)>& fn) const override;
+    std::size_t size() const override;
+    int max_id() const override;
+    bool durable() const override { return true; }
+    bool accepts(std::string_view username, std::string_view password) const override {
+        return UserTable::fits(username, password);
+    }
+
+    const UserTable& table() const { return m_table; }
+    std::uint64_t replayed_records() const { return m_replayed; }
+
+private:
+    UserTable m_table;
+    MemoryUserStore m_overlay;
+    UserLog m_log;
+    std::uint64_t m_replayed = 0;
+};
@@ -0,0 +1,242 @@
+#include "memory_user_store.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Ejecuta fn(t) para t en [0, threads) en paralelo
+template <typename Fn>
+void parallel_for(unsigned threads, Fn&& fn) {
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.emplace_back(fn, t);
+    }
+    fn(0u);
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+}  // namespace
+
+std::optional<User> MemoryUserStore::find_by_username(std::string_view username) const {
+    const User* user = lookup(username);
+    return user ? std::optional<User>(*user) : std::nullopt;
+}
+
+std::optional<User> MemoryUserStore::find_by_id(int id) const {
+    const User* user = lookup(id);
+    return user ? std::optional<User>(*user) : std::nullopt;
+}
+
+bool MemoryUserStore::insert_if_absent(const User& user) {
+    const User* stored = nullptr;
+    {
+        UsernameShard& shard = shard_for(user.username);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.by_username.count(user.username) > 0 || shard.reserved.count(user.username) > 0) {
+            return false;
+        }
+        stored = store_in(shard, user);
+    }
+    index_by_id(stored);
+    return true;
+}
+
+bool MemoryUserStore::reserve_username(std::string_view username) {
+    UsernameShard& shard = shard_for(username);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.by_username.count(username) > 0) {
+        return false;
+    }
+    return shard.reserved.emplace(username).second;
+}
+
+void MemoryUserStore::publish(const User& user) {
+    const User* stored = nullptr;
+    {
+        UsernameShard& shard = shard_for(user.username);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.reserved.erase(user.username);
+        stored = store_in(shard, user);
+    }
+    index_by_id(stored);
+}
+
+void MemoryUserStore::release_username(std::string_view username) {
+    UsernameShard& shard = shard_for(username);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.reserved.erase(std::string(username));
+}
+
+const User* MemoryUserStore::store_in(UsernameShard& shard, const User& user) {
+    shard.users.push_back(user);
+    const User* stored = &shard.users.back();
+    shard.by_username.emplace(stored->username, stored);
+    return stored;
+}
+
+void MemoryUserStore::index_by_id(const User* stored) {
+    {
+        IdShard& id_shard = shard_for(stored->id);
+        std::unique_lock<std::shared_mutex> lock(id_shard.mutex);
+        id_shard.by_id.emplace(stored->id, stored);
+    }
+    index_id(stored->id);
+}
+
+const User* MemoryUserStore::lookup(std::string_view username) const {
+    const UsernameShard& shard = shard_for(username);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.by_username.find(username);
+    return it == shard.by_username.end() ? nullptr : it->second;
+}
+
+const User* MemoryUserStore::lookup(int id) const {
+    const IdShard& shard = shard_for(id);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.by_id.find(id);
+    return it == shard.by_id.end() ? nullptr : it->second;
+}
+
+std::vector<User> MemoryUserStore::page(int after_id, std::size_t limit) const {
+    std::vector<User> result;
+    result.reserve(std::min<std::size_t>(limit, 4096));
+    for (int id = m_ids.next(after_id); id != IdIndex::kNone && result.size() < limit; id = m_ids.next(id)) {
+        if (const User* user = lookup(id)) {
+            result.push_back(*user);
+        }
+    }
+    return result;
+}
+
+void MemoryUserStore::for_each(const std::function<void(const User&)>& fn) const {
+    for_each_record(fn);
+}
+
+std::size_t MemoryUserStore::size() const {
+    std::size_t total = 0;
+    for (const auto& shard : m_username_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.users.size();
+    }
+    return total;
+}
+
+void MemoryUserStore::for_each_shard(const std::function<void(const std::vector<const User*>&)>& fn) const {
+    std::vector<const User*> records;
+    for (const auto& shard : m_username_shards) {
+        records.clear();
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            records.reserve(shard.users.size());
+            for (const auto& user : shard.users) {
+                records.push_back(&user);
+            }
+        }
+        fn(records);
+    }
+}
+
+int MemoryUserStore::max_id() const {
+    return m_max_id.load(std::memory_order_acquire);
+}
+
+void MemoryUserStore::reserve(std::size_t count) {
+    const std::size_t per_shard = count / kShardCount + 1;
+    for (auto& shard : m_username_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.by_username.reserve(per_shard);
+    }
+    for (auto& shard : m_id_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.by_id.reserve(per_shard);
+    }
+}
+
+std::size_t MemoryUserStore::bulk_load(std::vector<User>& users, unsigned threads) {
+    threads = std::max(1u, std::min<unsigned>(threads, kShardCount));
+
+    // 1. Índice por username: cada hilo inserta sólo en sus shards
+    std::array<std::vector<User*>, kShardCount> by_shard;
+    for (auto& user : users) {
+        by_shard[shard_index(user.username)].push_back(&user);
+    }
+
+    std::vector<std::vector<const User*>> stored(threads);
+    parallel_for(threads, [&](unsigned t) {
+        for (std::size_t s = t; s < kShardCount; s += threads) {
+            UsernameShard& shard = m_username_shards[s];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (User* user : by_shard[s]) {
+                if (shard.by_username.count(user->username) > 0) {
+                    continue;
+                }
+                shard.users.push_back(std::move(*user));
+                const User* record = &shard.users.back();
+                shard.by_username.emplace(record->username, record);
+                stored[t].push_back(record);
+            }
+        }
+    });
+
+    // 2. Índice por id, con el mismo reparto
+    std::array<std::vector<const User*>, kShardCount> by_id_shard;
+    std::size_t inserted = 0;
+    for (const auto& records : stored) {
+        inserted += records.size();
+        for (const User* record : records) {
+            by_id_shard[shard_index(record->id)].push_back(record);
+        }
+    }
+
+    parallel_for(threads, [&](unsigned t) {
+        for (std::size_t s = t; s < kShardCount; s += threads) {
+            IdShard& shard = m_id_shards[s];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (const User* record : by_id_shard[s]) {
+                shard.by_id.emplace(record->id, record);
+            }
+        }
+    });
+    for (const auto& records : stored) {
+        for (const User* record : records) {
+            index_id(record->id);
+        }
+    }
+    return inserted;
+}
+
+void MemoryUserStore::index_id(int id) {
+    m_ids.insert(id);
+    int max = m_max_id.load(std::memory_order_relaxed);
+    while (id > max && !m_max_id.compare_exchange_weak(max, id, std::memory_order_release)) {
+    }
+}
+
+std::size_t MemoryUserStore::shard_index(std::string_view username) {
+    return std::hash<std::string_view>{}(username) % kShardCount;
+}
+
+std::size_t MemoryUserStore::shard_index(int id) {
+    return static_cast<unsigned>(id) % kShardCount;
+}
+
+MemoryUserStore::UsernameShard& MemoryUserStore::shard_for(std::string_view username) {
+    return m_username_shards[shard_index(username)];
+}
+
+const MemoryUserStore::UsernameShard& MemoryUserStore::shard_for(std::string_view username) const {
+    return m_username_shards[shard_index(username)];
+}
+
+MemoryUserStore::IdShard& MemoryUserStore::shard_for(int id) {
+    return m_id_shards[shard_index(id)];
+}
+
+const MemoryUserStore::IdShard& MemoryUserStore::shard_for(int id) const {
+    return m_id_shards[shard_index(id)];
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "id_index.h"
+#include "user_store.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Motor en memoria, seguro para los hilos de Crow.
+//
+// Los datos se reparten en shards por hash del username, cada uno con su
+// propio shared_mutex: un /register sólo bloquea su shard y los /login de
+// otros shards nunca esperan. El índice por id va en shards aparte (por id).
+// Los registros viven en deques y nunca se borran ni se modifican, así que
+// los punteros de lookup() siguen siendo válidos sin mantener el lock.
+//
+// page() no recorre el motor: salta de id en id con un IdIndex (bitmap
+// ordenado, sin locks) y los busca en los shards por id, así que una página
+// cuesta O(limit) esté donde esté. Los ids negativos no entran en page().
+class MemoryUserStore : public UserStore {
+public:
+    static constexpr std::size_t kShardCount = 64;
+
+    const char* name() const override { return "memory"; }
+
+    std::optional<User> find_by_username(std::string_view username) const override;
+    std::optional<User> find_by_id(int id) const override;
+    bool insert_if_absent(const User& user) override;
+    std::vector<User> page(int after_id, std::size_t limit) const override;
+    void for_each(const std::function<void(const User&)>& fn) const override;
+    std::size_t size() const override;
+    int max_id() const override;
+
+    // Búsqueda sin copia para quien conoce el motor concreto; nullptr si no existe
+    const User* lookup(std::string_view username) const;
+    const User* lookup(int id) const;
+
+    void reserve(std::size_t count);
+
+    // Alta en dos fases para los motores con log (primero el log, luego la
+    // memoria): reserve_username() aparta el nombre sin hacerlo visible (las
+    // búsquedas no lo ven, otro alta del mismo nombre falla); publish() lo
+    // inserta de verdad y release_username() deshace la reserva.
+    bool reserve_username(std::string_view username);
+    void publish(const User& user);
+    void release_username(std::string_view username);
+
+    // Recorre los registros shard a shard copiando sólo los punteros bajo el
+    // lock; fn se ejecuta ya sin lock, así que puede ser lenta (p. ej. escribir
+    // un snapshot) sin frenar a los handlers.
+    void for_each_shard(const std::function<void(const std::vector<const User*>&)>& fn) const;
+
+    // Carga masiva (recuperación al arrancar): reparte los shards entre
+    // `threads` hilos para que no compitan por los locks. Mueve los usuarios
+    // insertados fuera de `users`; devuelve cuántos se insertaron.
+    std::size_t bulk_load(std::vector<User>& users, unsigned threads);
+
+private:
+    struct alignas(64) UsernameShard {
+        mutable std::shared_mutex mutex;
+        std::deque<User> users;
+        std::unordered_map<std::string_view, const User*> by_username;
+        std::unordered_set<std::string> reserved;  // altas a la espera del log
+    };
+
+    struct alignas(64) IdShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<int, const User*> by_id;
+    };
+
+    static std::size_t shard_index(std::string_view username);
+    static std::size_t shard_index(int id);
+
+    UsernameShard& shard_for(std::string_view username);
+    const UsernameShard& shard_for(std::string_view username) const;
+    IdShard& shard_for(int id);
+    const IdShard& shard_for(int id) const;
+
+    // Visita los registros shard a shard bajo lock compartido
+    template <typename Fn>
+    void for_each_record(Fn&& fn) const {
+        for (const auto& shard : m_username_shards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& user : shard.users) {
+                fn(user);
+            }
+        }
+    }
+
+    // Inserta en el shard de usernames ya bloqueado y devuelve el registro
+    static const User* store_in(UsernameShard& shard, const User& user);
+    // Publica en su IdShard, m_ids y m_max_id un registro ya almacenado
+    void index_by_id(const User* stored);
+    // Publica en m_ids y m_max_id un id que ya está en su IdShard
+    void index_id(int id);
+
+    std::array<UsernameShard, kShardCount> m_username_shards;
+    std::array<IdShard, kShardCount> m_id_shards;
+    IdIndex m_ids;
+    std::atomic<int> m_max_id{0};
+};
@@ -0,0 +1,87 @@
+#include "pg_connection_pool.h"
+
+#include <chrono>
+#include <iostream>
+
+PgConnectionPool::PgConnectionPool(std::string url, std::size_t size,
+                                   std::function<void(pqxx::connection&)> on_connect)
+    : m_url(std::move(url)), m_size(size > 0 ? size : 1), m_on_connect(std::move(on_connect)) {
+    m_idle.reserve(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_idle.push_back(connect());
+    }
+}
+
+PgConnectionPool::Lease PgConnectionPool::acquire() {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_available.wait(lock, [this] { return !m_idle.empty() || m_empty_slots > 0; });
+    std::unique_ptr<pqxx::connection> conn;
+    if (!m_idle.empty()) {
+        conn = std::move(m_idle.back());
+        m_idle.pop_back();
+        lock.unlock();
+    } else {
+        // Hueco de una conexión caída: se reconecta fuera del lock
+        --m_empty_slots;
+        lock.unlock();
+        try {
+            conn = connect();
+            m_reconnects.fetch_add(1, std::memory_order_relaxed);
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> relock(m_mutex);
+                ++m_empty_slots;
+            }
+            m_available.notify_one();
+            throw;
+        }
+    }
+
+    const auto waited = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    m_wait_ns_total.fetch_add(waited, std::memory_order_relaxed);
+    std::uint64_t max = m_wait_ns_max.load(std::memory_order_relaxed);
+    while (waited > max && !m_wait_ns_max.compare_exchange_weak(max, waited, std::memory_order_relaxed)) {
+    }
+
+    return Lease(*this, std::move(conn));
+}
+
+PgConnectionPool::Stats PgConnectionPool::stats() const {
+    Stats s;
+    s.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+    s.wait_ns_total = m_wait_ns_total.load(std::memory_order_relaxed);
+    s.wait_ns_max = m_wait_ns_max.load(std::memory_order_relaxed);
+    s.reconnects = m_reconnects.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::unique_ptr<pqxx::connection> PgConnectionPool::connect() {
+    auto conn = std::make_unique<pqxx::connection>(m_url);
+    if (m_on_connect) {
+        m_on_connect(*conn);
+    }
+    return conn;
+}
+
+void PgConnectionPool::release(std::unique_ptr<pqxx::connection> conn) {
+    // Una conexión caída no vuelve al pool: se cierra y su hueco se reabre en acquire()
+    const bool open = conn->is_open();
+    if (!open) {
+        std::cerr << "⚠️ Conexión a PostgreSQL caída; se reabrirá al pedirla" << std::endl;
+        conn.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (open) {
+            m_idle.push_back(std::move(conn));
+        } else {
+            ++m_empty_slots;
+        }
+    }
+    m_available.notify_one();
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <pqxx/pqxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Pool de tamaño fijo de conexiones PostgreSQL compartido por los hilos de Crow.
+// Las conexiones se abren una vez al arrancar y se preparan con on_connect
+// (p. ej. sentencias preparadas); acquire() bloquea si todas están ocupadas.
+// Una conexión que vuelve caída se descarta y deja su hueco libre: el
+// siguiente acquire() sin conexiones ociosas abre otra en ese hueco (y si no
+// puede, lanza y el hueco sigue libre), así que el pool nunca encoge.
+class PgConnectionPool {
+public:
+    struct Stats {
+        std::uint64_t acquisitions = 0;
+        std::uint64_t wait_ns_total = 0;  // tiempo esperando una conexión libre
+        std::uint64_t wait_ns_max = 0;
+        std::uint64_t reconnects = 0;
+    };
+
+    // Conexión prestada; vuelve al pool al destruirse
+    class Lease {
+    public:
+        Lease(PgConnectionPool& pool, std::unique_ptr<pqxx::connection> conn)
+            : m_pool(&pool), m_conn(std::move(conn)) {}
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() {
+            if (m_conn) {
+                m_pool->release(std::move(m_conn));
+            }
+        }
+
+        pqxx::connection& operator*() { return *m_conn; }
+        pqxx::connection* operator->() { return m_conn.get(); }
+
+    private:
+        PgConnectionPool* m_pool;
+        std::unique_ptr<pqxx::connection> m_conn;
+    };
+
+    PgConnectionPool(std::string url, std::size_t size, std::function<void(pqxx::connection&)> on_connect);
+
+    Lease acquire();
+
+    std::size_t size() const { return m_size; }
+    Stats stats() const;
+
+private:
+    std::unique_ptr<pqxx::connection> connect();
+    void release(std::unique_ptr<pqxx::connection> conn);
+
+    const std::string m_url;
+    const std::size_t m_size;
+    const std::function<void(pqxx::connection&)> m_on_connect;
+
+    std::mutex m_mutex;
+    std::condition_variable m_available;
+    std::vector<std::unique_ptr<pqxx::connection>> m_idle;
+    std::size_t m_empty_slots = 0;  // conexiones descartadas por caídas, a reabrir
+
+    std::atomic<std::uint64_t> m_acquisitions{0};
+    std::atomic<std::uint64_t> m_wait_ns_total{0};
+    std::atomic<std::uint64_t> m_wait_ns_max{0};
+    std::atomic<std::uint64_t> m_reconnects{0};
+};
@@ -0,0 +1,154 @@
+#include "pg_user_store.h"
+
+#include <chrono>
+
+namespace {
+
+User row_to_user(const pqxx::row& row) {
+    return User{row[1].as<std::string>(), row[2].as<std::string>(), row[0].as<int>()};
+}
+
+}  // namespace
+
+PgUserStore::PgUserStore(const std::string& url, std::size_t pool_size, const std::string& table)
+    : m_table(table),
+      m_pool(url, pool_size, [table](pqxx::connection& conn) { prepare_statements(conn, table); }) {}
+
+void PgUserStore::prepare_statements(pqxx::connection& conn, const std::string& table) {
+    const std::string t = conn.quote_name(table);
+
+    {
+        pqxx::nontransaction tx(conn);
+        tx.exec0("CREATE TABLE IF NOT EXISTS " + t + " ("
+                 "id INTEGER PRIMARY KEY, "
+                 "username TEXT NOT NULL UNIQUE, "
+                 "password TEXT NOT NULL)");
+    }
+
+    conn.prepare("find_by_username", "SELECT id, username, password FROM " + t + " WHERE username = $1");
+    conn.prepare("find_by_id", "SELECT id, username, password FROM " + t + " WHERE id = $1");
+    conn.prepare("insert_user",
+                 "INSERT INTO " + t + " (id, username, password) VALUES ($1, $2, $3) "
+                 "ON CONFLICT (username) DO NOTHING");
+    conn.prepare("page_users",
+                 "SELECT id, username, password FROM " + t + " WHERE id > $1 ORDER BY id LIMIT $2");
+    conn.prepare("count_users", "SELECT count(*) FROM " + t);
+    conn.prepare("max_user_id", "SELECT COALESCE(max(id), 0) FROM " + t);
+}
+
+template <typename Fn>
+auto PgUserStore::with_connection(Fn&& fn) const {
+    PgConnectionPool::Lease conn = m_pool.acquire();
+
+    const auto start = std::chrono::steady_clock::now();
+    struct Timer {
+        const PgUserStore* self;
+        std::chrono::steady_clock::time_point start;
+        ~Timer() {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            self->m_queries.fetch_add(1, std::memory_order_relaxed);
+            self->m_query_ns_total.fetch_add(static_cast<std::uint64_t>(ns), std::memory_order_relaxed);
+        }
+    } timer{this, start};
+
+    return fn(*conn);
+}
+
+std::optional<User> PgUserStore::find_by_username(std::string_view username) const {
+    return with_connection([&](pqxx::connection& conn) -> std::optional<User> {
+        pqxx::nontransaction tx(conn);
+        pqxx::result r = tx.exec_prepared("find_by_username", username);
+        if (r.empty()) {
+            return std::nullopt;
+        }
+        return row_to_user(r[0]);
+    });
+}
+
+std::optional<User> PgUserStore::find_by_id(int id) const {
+    return with_connection([&](pqxx::connection& conn) -> std::optional<User> {
+        pqxx::nontransaction tx(conn);
+        pqxx::result r = tx.exec_prepared("find_by_id", id);
+        if (r.empty()) {
+            return std::nullopt;
+        }
+        return row_to_user(r[0]);
+    });
+}
+
+bool PgUserStore::insert_if_absent(const User& user) {
+    return with_connection([&](pqxx::connection& conn) {
+        pqxx::nontransaction tx(conn);
+        pqxx::result r = tx.exec_prepared("insert_user", user.id, user.username, user.password);
+        return r.affected_rows() == 1;
+    });
+}
+
+std::vector<bool> PgUserStore::insert_batch(const std::vector<User>& users) {
+    return with_connection([&](pqxx::connection& conn) {
+        // Todo el lote en una transacción: un solo commit (y un solo fsync del WAL)
+        pqxx::work tx(conn);
+        std::vector<bool> inserted;
+        inserted.reserve(users.size());
+        for (const auto& user : users) {
+            pqxx::result r = tx.exec_prepared("insert_user", user.id, user.username, user.password);
+            inserted.push_back(r.affected_rows() == 1);
+        }
+        tx.commit();
+        return inserted;
+    });
+}
+
+std::vector<User> PgUserStore::page(int after_id, std::size_t limit) const {
+    return with_connection([&](pqxx::connection& conn) {
+        pqxx::nontransaction tx(conn);
+        pqxx::result r = tx.exec_prepared("page_users", after_id, static_cast<long long>(limit));
+        std::vector<User> users;
+        users.reserve(r.size());
+        for (const auto& row : r) {
+            users.push_back(row_to_user(row));
+        }
+        return users;
+    });
+}
+
+void PgUserStore::for_each(const std::function<void(const User&)>& fn) const {
+    int last_id = 0;
+    for (auto users = page(last_id, 10000); !users.empty(); users = page(last_id, 10000)) {
+        for (const auto& user : users) {
+            fn(user);
+        }
+        last_id = users.back().id;
+    }
+}
+
+std::size_t PgUserStore::size() const {
+    return with_connection([](pqxx::connection& conn) {
+        pqxx::nontransaction tx(conn);
+        return tx.exec_prepared1("count_users")[0].as<std::size_t>();
+    });
+}
+
+int PgUserStore::max_id() const {
+    return with_connection([](pqxx::connection& conn) {
+        pqxx::nontransaction tx(conn);
+        return tx.exec_prepared1("max_user_id")[0].as<int>();
+    });
+}
+
+void PgUserStore::truncate() {
+    with_connection([this](pqxx::connection& conn) {
+        pqxx::nontransaction tx(conn);
+        tx.exec0("TRUNCATE " + conn.quote_name(m_table));
+        return 0;
+    });
+}
+
+PgUserStore::Stats PgUserStore::stats() const {
+    Stats s;
+    s.pool = m_pool.stats();
+    s.queries = m_queries.load(std::memory_order_relaxed);
+    s.query_ns_total = m_query_ns_total.load(std::memory_order_relaxed);
+    return s;
+}
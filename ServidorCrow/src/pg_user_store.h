@@ -0,0 +1,52 @@
+#pragma once
+
+#include "pg_connection_pool.h"
+#include "user_store.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Motor PostgreSQL. Comparte un pool fijo de conexiones entre los hilos de
+// Crow y usa sentencias preparadas en el servidor: un /login es un único
+// round trip sin parse/plan (nontransaction, sin BEGIN/COMMIT).
+class PgUserStore : public UserStore {
+public:
+    struct Stats {
+        PgConnectionPool::Stats pool;
+        std::uint64_t queries = 0;
+        std::uint64_t query_ns_total = 0;  // sin contar la espera del pool
+    };
+
+    // `table` permite aislar los benchmarks de la tabla real
+    PgUserStore(const std::string& url, std::size_t pool_size, const std::string& table = "users");
+
+    const char* name() const override { return "postgres"; }
+
+    std::optional<User> find_by_username(std::string_view username) const override;
+    std::optional<User> find_by_id(int id) const override;
+    bool insert_if_absent(const User& user) override;
+    std::vector<bool> insert_batch(const std::vector<User>& users) override;
+    bool durable() const override { return true; }
+    std::vector<User> page(int after_id, std::size_t limit) const override;
+    void for_each(const std::function<void(const User&)>& fn) const override;
+    std::size_t size() const override;
+    int max_id() const override;
+
+    // Vacía la tabla (sólo benchmarks)
+    void truncate();
+
+    Stats stats() const;
+
+private:
+    // Ejecuta fn con una conexión del pool, midiendo el tiempo de consulta
+    template <typename Fn>
+    auto with_connection(Fn&& fn) const;
+
+    static void prepare_statements(pqxx::connection& conn, const std::string& table);
+
+    const std::string m_table;
+    mutable PgConnectionPool m_pool;
+    mutable std::atomic<std::uint64_t> m_queries{0};
+    mutable std::atomic<std::uint64_t> m_query_ns_total{0};
+};
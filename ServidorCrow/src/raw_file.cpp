@@ -0,0 +1,205 @@
+#include "raw_file.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw std::system_error(errno, std::generic_category(), what + " " + path);
+}
+
+}  // namespace
+
+RawFile::RawFile(const std::string& path, Mode mode) : m_path(path) {
+#ifdef _WIN32
+    int flags = _O_BINARY;
+    switch (mode) {
+        case Mode::Read: flags |= _O_RDONLY; break;
+        case Mode::Append: flags |= _O_RDWR | _O_CREAT; break;
+        case Mode::Truncate: flags |= _O_WRONLY | _O_CREAT | _O_TRUNC; break;
+    }
+    m_fd = _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_CLOEXEC;
+    switch (mode) {
+        case Mode::Read: flags |= O_RDONLY; break;
+        case Mode::Append: flags |= O_RDWR | O_CREAT; break;
+        case Mode::Truncate: flags |= O_WRONLY | O_CREAT | O_TRUNC; break;
+    }
+    m_fd = ::open(path.c_str(), flags, 0644);
+#endif
+    if (m_fd < 0) {
+        fail("open", path);
+    }
+    if (mode == Mode::Append) {
+        seek(size());
+    }
+}
+
+RawFile::~RawFile() {
+    if (m_fd >= 0) {
+#ifdef _WIN32
+        _close(m_fd);
+#else
+        ::close(m_fd);
+#endif
+    }
+}
+
+RawFile::RawFile(RawFile&& other) noexcept
+    : m_fd(std::exchange(other.m_fd, -1)), m_path(std::move(other.m_path)) {}
+
+RawFile& RawFile::operator=(RawFile&& other) noexcept {
+    if (this != &other) {
+        std::swap(m_fd, other.m_fd);
+        std::swap(m_path, other.m_path);
+    }
+    return *this;
+}
+
+void RawFile::write_all(const void* data, std::size_t size) {
+    const auto* p = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef _WIN32
+        int n = _write(m_fd, p, static_cast<unsigned>(size > 0x40000000 ? 0x40000000 : size));
+#else
+        ssize_t n = ::write(m_fd, p, size);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail("write", m_path);
+        }
+        p += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+std::size_t RawFile::read(void* data, std::size_t size) {
+    while (true) {
+#ifdef _WIN32
+        int n = _read(m_fd, data, static_cast<unsigned>(size > 0x40000000 ? 0x40000000 : size));
+#else
+        ssize_t n = ::read(m_fd, data, size);
+#endif
+        if (n >= 0) {
+            return static_cast<std::size_t>(n);
+        }
+        if (errno != EINTR) {
+            fail("read", m_path);
+        }
+    }
+}
+
+void RawFile::seek(std::uint64_t offset) {
+#ifdef _WIN32
+    bool ok = _lseeki64(m_fd, static_cast<__int64>(offset), SEEK_SET) >= 0;
+#else
+    bool ok = ::lseek(m_fd, static_cast<off_t>(offset), SEEK_SET) >= 0;
+#endif
+    if (!ok) {
+        fail("seek", m_path);
+    }
+}
+
+std::uint64_t RawFile::size() const {
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_fstat64(m_fd, &st) != 0) {
+        fail("stat", m_path);
+    }
+#else
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0) {
+        fail("stat", m_path);
+    }
+#endif
+    return static_cast<std::uint64_t>(st.st_size);
+}
+
+void RawFile::truncate(std::uint64_t size) {
+#ifdef _WIN32
+    bool ok = _chsize_s(m_fd, static_cast<__int64>(size)) == 0;
+#else
+    bool ok = ::ftruncate(m_fd, static_cast<off_t>(size)) == 0;
+#endif
+    if (!ok) {
+        fail("truncate", m_path);
+    }
+}
+
+void RawFile::sync() {
+#ifdef _WIN32
+    bool ok = _commit(m_fd) == 0;
+#elif defined(__APPLE__)
+    bool ok = ::fsync(m_fd) == 0;
+#else
+    bool ok = ::fdatasync(m_fd) == 0;
+#endif
+    if (!ok) {
+        fail("sync", m_path);
+    }
+}
+
+void RawFile::close() {
+    RawFile closed;
+    std::swap(*this, closed);
+}
+
+bool RawFile::exists(const std::string& path) {
+#ifdef _WIN32
+    struct _stat64 st;
+    return _stat64(path.c_str(), &st) == 0;
+#else
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+#endif
+}
+
+void RawFile::replace(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    bool ok = MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    if (!ok) {
+        errno = EIO;
+    }
+#else
+    bool ok = std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    if (!ok) {
+        fail("rename", from + " ->");
+    }
+}
+
+void RawFile::sync_directory(const std::string& path) {
+#ifndef _WIN32
+    const std::size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    const int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fail("open", directory);
+    }
+    const bool ok = ::fsync(fd) == 0;
+    const int error = errno;
+    ::close(fd);
+    if (!ok) {
+        errno = error;
+        fail("sync", directory);
+    }
+#else
+    (void)path;
+#endif
+}
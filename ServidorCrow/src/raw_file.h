@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fichero con descriptor crudo (POSIX o CRT de Windows) para el log y los
+// snapshots: escrituras sin buffer intermedio y sync() explícito.
+// Los errores se lanzan como std::system_error.
+class RawFile {
+public:
+    enum class Mode {
+        Read,      // sólo lectura; debe existir
+        Append,    // lectura/escritura al final; se crea si no existe
+        Truncate,  // escritura; se crea o se vacía
+    };
+
+    RawFile() = default;
+    RawFile(const std::string& path, Mode mode);
+    ~RawFile();
+
+    RawFile(RawFile&& other) noexcept;
+    RawFile& operator=(RawFile&& other) noexcept;
+    RawFile(const RawFile&) = delete;
+    RawFile& operator=(const RawFile&) = delete;
+
+    bool is_open() const { return m_fd >= 0; }
+    const std::string& path() const { return m_path; }
+
+    void write_all(const void* data, std::size_t size);
+    // Lee hasta `size` bytes; devuelve 0 al llegar al final
+    std::size_t read(void* data, std::size_t size);
+    void seek(std::uint64_t offset);
+    std::uint64_t size() const;
+    void truncate(std::uint64_t size);
+    // Espera a que los datos escritos estén en disco (fdatasync / _commit)
+    void sync();
+    void close();
+
+    static bool exists(const std::string& path);
+    // rename atómico que reemplaza el destino si existe
+    static void replace(const std::string& from, const std::string& to);
+    // Hace duraderos un alta o un rename en el directorio de `path` (fsync del
+    // directorio); en Windows ya lo hace MOVEFILE_WRITE_THROUGH
+    static void sync_directory(const std::string& path);
+
+private:
+    int m_fd = -1;
+    std::string m_path;
+};
@@ -0,0 +1,43 @@
+#include "response_bodies.h"
+
+#include "json_writer.h"
+
+std::string session_response(std::string_view message, int user_id, std::string_view username,
+                             std::string_view token, std::string_view refresh_token,
+                             std::chrono::seconds expires_in) {
+    JsonWriter out(128 + message.size() + username.size() + token.size() + refresh_token.size());
+    out.begin_object().key("expires_in").value(expires_in.count());
+    if (!message.empty()) {
+        out.key("message").value(message);
+    }
+    out.key("refresh_token").value(refresh_token)
+        .key("success").value(true)
+        .key("token").value(token)
+        .key("user").begin_object()
+            .key("id").value(user_id)
+            .key("username").value(username)
+        .end_object()
+    .end_object();
+    return out.take();
+}
+
+std::string users_response(const std::vector<std::pair<int, std::string>>& users) {
+    // {"id":,"username":""}, son 22 bytes fijos por usuario, más el id y el nombre
+    std::size_t size = 32;
+    for (const auto& user : users) {
+        size += 34 + user.second.size();
+    }
+    JsonWriter out(size);
+    out.begin_object().key("success").value(true).key("users").begin_array();
+    for (const auto& [id, username] : users) {
+        out.begin_object().key("id").value(id).key("username").value(username).end_object();
+    }
+    out.end_array().end_object();
+    return out.take();
+}
+
+std::string error_response(std::string_view message) {
+    JsonWriter out(32 + message.size());
+    out.begin_object().key("error").value(message).key("success").value(false).end_object();
+    return out.take();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Cuerpos de respuesta de forma fija, escritos con JsonWriter en lugar de
+// construir un nlohmann::json y llamar a dump(). Los bytes son los mismos
+// que daba dump() (claves en orden alfabético); bench_responses lo comprueba.
+
+// Éxito de /register, /login y /refresh (este sin message: se omite si está vacío):
+//   {"expires_in":900,"message":"Login exitoso","refresh_token":"...","success":true,
+//    "token":"...","user":{"id":1,"username":"juan"}}
+std::string session_response(std::string_view message, int user_id, std::string_view username,
+                             std::string_view token, std::string_view refresh_token,
+                             std::chrono::seconds expires_in);
+
+// GET /users con los usuarios ya ordenados por id:
+//   {"success":true,"users":[{"id":1,"username":"juan"},...]}
+std::string users_response(const std::vector<std::pair<int, std::string>>& users);
+
+// Error con mensaje variable (los fijos están en error_responses.h):
+//   {"error":"Como máximo 1000 tokens por lote","success":false}
+std::string error_response(std::string_view message);
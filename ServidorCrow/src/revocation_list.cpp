@@ -0,0 +1,230 @@
+#include "revocation_list.h"
+
+#include "coarse_clock.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+constexpr std::size_t kBlockWords = 8;    // 512 bits = una línea de caché
+constexpr int kProbes = 7;                // 7 x 9 bits del hash secundario
+constexpr std::size_t kBitsPerEntry = 16; // ~0,1-0,2 % de falsos positivos
+
+struct Probe {
+    std::size_t block;
+    std::uint64_t secondary;
+};
+
+Probe probe_for(std::string_view jti, std::size_t block_mask) {
+    const std::uint64_t h = std::hash<std::string_view>{}(jti);
+    // Mezcla (splitmix64) para que bloque y posiciones no compartan bits
+    std::uint64_t z = h + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return Probe{static_cast<std::size_t>(h) & block_mask, z};
+}
+
+// Contador de lectores de cada hilo (reparto fijo al primer uso)
+std::atomic<std::size_t> g_next_stripe{0};
+
+}  // namespace
+
+// Lector anunciado en la época actual mientras dura la sección. Si la época
+// cambia entre anunciarse y comprobarla, reintenta: así quien publica sabe que
+// todo lector de la época nueva ya ve el filtro nuevo.
+class RevocationList::ReadSection {
+public:
+    explicit ReadSection(const RevocationList& list) {
+        thread_local const std::size_t stripe = g_next_stripe.fetch_add(1) % kReaderStripes;
+        while (true) {
+            const std::uint64_t epoch = list.m_epoch.load();
+            m_count = &list.m_readers[epoch & 1][stripe].count;
+            m_count->fetch_add(1);
+            if (list.m_epoch.load() == epoch) {
+                return;
+            }
+            m_count->fetch_sub(1);
+        }
+    }
+
+    ~ReadSection() { m_count->fetch_sub(1, std::memory_order_release); }
+
+    ReadSection(const ReadSection&) = delete;
+    ReadSection& operator=(const ReadSection&) = delete;
+
+private:
+    std::atomic<std::uint64_t>* m_count;
+};
+
+struct RevocationList::Filter {
+    std::size_t block_mask;
+    std::size_t capacity;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+
+    void add(std::string_view jti) {
+        const Probe p = probe_for(jti, block_mask);
+        std::atomic<std::uint64_t>* block = &words[p.block * kBlockWords];
+        for (int i = 0; i < kProbes; ++i) {
+            const unsigned bit = (p.secondary >> (9 * i)) & 511;
+            block[bit >> 6].fetch_or(1ull << (bit & 63), std::memory_order_relaxed);
+        }
+    }
+
+    bool may_contain(std::string_view jti) const {
+        const Probe p = probe_for(jti, block_mask);
+        const std::atomic<std::uint64_t>* block = &words[p.block * kBlockWords];
+        for (int i = 0; i < kProbes; ++i) {
+            const unsigned bit = (p.secondary >> (9 * i)) & 511;
+            if (!(block[bit >> 6].load(std::memory_order_relaxed) & (1ull << (bit & 63)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t bytes() const { return (block_mask + 1) * kBlockWords * sizeof(std::uint64_t); }
+};
+
+RevocationList::RevocationList(std::size_t expected) : m_expected(expected ? expected : 1) {
+    publish(make_filter(m_expected));
+}
+
+RevocationList::~RevocationList() {
+    {
+        std::lock_guard<std::mutex> lock(m_thread_mutex);
+        m_stopping = true;
+    }
+    m_stop_cv.notify_all();
+    if (m_sweep_thread.joinable()) {
+        m_sweep_thread.join();
+    }
+}
+
+void RevocationList::revoke(std::string_view jti, std::int64_t expires_at) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_entries[std::string(jti)] = expires_at;
+
+    // Filtro lleno: se duplica ya, sin esperar al barrido
+    if (m_entries.size() > m_current->capacity) {
+        auto bigger = make_filter(m_current->capacity * 2);
+        for (const auto& [key, exp] : m_entries) {
+            bigger->add(key);
+        }
+        publish(std::move(bigger));
+    } else {
+        m_current->add(jti);
+    }
+}
+
+bool RevocationList::is_revoked(std::string_view jti) const {
+    bool maybe;
+    {
+        // Se sale antes del lock: publish() espera a los lectores con m_mutex tomado
+        const ReadSection section(*this);
+        maybe = m_filter.load()->may_contain(jti);
+    }
+    if (!maybe) {
+        return false;
+    }
+    m_filter_positives.fetch_add(1, std::memory_order_relaxed);
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    if (m_entries.count(std::string(jti))) {
+        return true;
+    }
+    m_false_positives.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+std::size_t RevocationList::sweep() {
+    const std::int64_t now = CoarseClock::now_seconds();
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    std::size_t removed = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second <= now) {
+            it = m_entries.erase(it);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+
+    auto rebuilt = make_filter(std::max(m_expected, m_entries.size() * 2));
+    for (const auto& [key, exp] : m_entries) {
+        rebuilt->add(key);
+    }
+    publish(std::move(rebuilt));
+    return removed;
+}
+
+void RevocationList::start_sweeper(std::chrono::seconds interval) {
+    if (m_sweep_thread.joinable()) {
+        return;
+    }
+    m_sweep_thread = std::thread([this, interval] { sweep_loop(interval); });
+}
+
+RevocationList::Stats RevocationList::stats() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    Stats s;
+    s.entries = m_entries.size();
+    s.filter_bytes = m_current->bytes();
+    s.filter_positives = m_filter_positives.load(std::memory_order_relaxed);
+    s.false_positives = m_false_positives.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::unique_ptr<RevocationList::Filter> RevocationList::make_filter(std::size_t capacity) {
+    std::size_t blocks = 1;
+    while (blocks * kBlockWords * 64 < capacity * kBitsPerEntry) {
+        blocks <<= 1;
+    }
+    auto filter = std::make_unique<Filter>();
+    filter->block_mask = blocks - 1;
+    filter->capacity = capacity;
+    filter->words = std::make_unique<std::atomic<std::uint64_t>[]>(blocks * kBlockWords);
+    for (std::size_t i = 0; i < blocks * kBlockWords; ++i) {
+        filter->words[i].store(0, std::memory_order_relaxed);
+    }
+    return filter;
+}
+
+// Llamar con m_mutex exclusivo (o desde el constructor)
+void RevocationList::publish(std::unique_ptr<Filter> filter) {
+    m_filter.store(filter.get());
+    std::unique_ptr<Filter> previous = std::move(m_current);
+    m_current = std::move(filter);
+    if (previous) {
+        wait_for_readers();
+    }
+}
+
+// Tras publicar: los lectores que aún pueden tener el filtro anterior son los
+// anunciados en la época actual. Se pasa a la siguiente (los nuevos ya leen el
+// filtro nuevo) y se espera a que se vacíe la actual; sólo dura lo que tarda
+// una consulta al filtro.
+void RevocationList::wait_for_readers() {
+    const std::uint64_t epoch = m_epoch.load();
+    m_epoch.store(epoch + 1);
+    for (const ReaderCount& reader : m_readers[epoch & 1]) {
+        while (reader.count.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void RevocationList::sweep_loop(std::chrono::seconds interval) {
+    std::unique_lock<std::mutex> lock(m_thread_mutex);
+    while (!m_stop_cv.wait_for(lock, interval, [this] { return m_stopping; })) {
+        lock.unlock();
+        const std::size_t removed = sweep();
+        if (removed) {
+            std::cout << "🧹 Revocaciones: " << removed << " tokens caducados eliminados" << std::endl;
+        }
+        lock.lock();
+    }
+}
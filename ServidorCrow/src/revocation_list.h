@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+// Tokens revocados (logout), indexados por su jti.
+//
+// Delante del conjunto hay un filtro de Bloom por bloques: los k bits de un
+// jti caen en el mismo bloque de 64 bytes, así que el caso común (token no
+// revocado) es leer una línea de caché con cargas atómicas relajadas, sin
+// locks. Sólo si el filtro dice "quizá" se toma el lock compartido y se
+// consulta el mapa.
+//
+// Cada entrada vive hasta el exp del token: pasado ese momento el token ya no
+// es válido de todos modos. El barrido (hilo de fondo) borra las entradas
+// caducadas y reconstruye el filtro, que se publica con un intercambio de
+// puntero. Para liberar el sustituido, los lectores se anuncian en contadores
+// por época (repartidos entre hilos, sin compartir línea de caché): quien
+// publica cambia de época y espera a que se vacíen los contadores de la
+// anterior, así que ningún lector puede seguir usando el filtro liberado.
+class RevocationList {
+public:
+    struct Stats {
+        std::size_t entries = 0;
+        std::size_t filter_bytes = 0;
+        std::uint64_t filter_positives = 0;  // consultas que pasaron el filtro
+        std::uint64_t false_positives = 0;   // ... y no estaban revocadas
+    };
+
+    // expected: revocaciones vivas para las que se dimensiona el filtro
+    explicit RevocationList(std::size_t expected = 1 << 16);
+    ~RevocationList();
+
+    RevocationList(const RevocationList&) = delete;
+    RevocationList& operator=(const RevocationList&) = delete;
+
+    void revoke(std::string_view jti, std::int64_t expires_at);
+    bool is_revoked(std::string_view jti) const;
+
+    // Borra las entradas caducadas y reconstruye el filtro; devuelve cuántas borró
+    std::size_t sweep();
+
+    // Lanza el hilo que llama a sweep() cada `interval`
+    void start_sweeper(std::chrono::seconds interval);
+
+    Stats stats() const;
+
+private:
+    struct Filter;
+    class ReadSection;
+
+    static constexpr std::size_t kReaderStripes = 32;
+
+    struct alignas(64) ReaderCount {
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    static std::unique_ptr<Filter> make_filter(std::size_t capacity);
+    // Publica el filtro y libera el anterior cuando no le quedan lectores
+    void publish(std::unique_ptr<Filter> filter);
+    void wait_for_readers();
+    void sweep_loop(std::chrono::seconds interval);
+
+    const std::size_t m_expected;
+    std::atomic<const Filter*> m_filter{nullptr};
+    std::atomic<std::uint64_t> m_epoch{0};
+    mutable ReaderCount m_readers[2][kReaderStripes];  // por paridad de época
+
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<std::string, std::int64_t> m_entries;  // jti -> exp
+    std::unique_ptr<Filter> m_current;
+
+    mutable std::atomic<std::uint64_t> m_filter_positives{0};
+    mutable std::atomic<std::uint64_t> m_false_positives{0};
+
+    std::mutex m_thread_mutex;
+    std::condition_variable m_stop_cv;
+    bool m_stopping = false;
+    std::thread m_sweep_thread;
+};
@@ -0,0 +1,266 @@
+#include "session_store.h"
+
+#include "base64url.h"
+#include "coarse_clock.h"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+void put_u32(unsigned char* out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint32_t get_u32(const unsigned char* in) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Secretos de RAND_bytes servidos desde un bloque por hilo: una llamada a
+// OpenSSL (con su lock del DRBG) cada 256 secretos en lugar de una por token
+void random_secret(unsigned char* out, std::size_t size) {
+    thread_local unsigned char pool[4096];
+    thread_local std::size_t used = sizeof(pool);
+    if (used + size > sizeof(pool)) {
+        if (RAND_bytes(pool, static_cast<int>(sizeof(pool))) != 1) {
+            throw std::runtime_error("RAND_bytes falló generando un refresh token");
+        }
+        used = 0;
+    }
+    std::memcpy(out, pool + used, size);
+    std::memset(pool + used, 0, size);
+    used += size;
+}
+
+}  // namespace
+
+SessionStore::SessionStore(std::chrono::seconds lifetime) : m_lifetime(lifetime) {
+    const std::int64_t now = CoarseClock::now_seconds();
+    for (auto& shard : m_shards) {
+        shard = std::make_unique<Shard>(now);
+    }
+}
+
+SessionStore::~SessionStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_thread_mutex);
+        m_stopping = true;
+    }
+    m_stop_cv.notify_all();
+    if (m_sweep_thread.joinable()) {
+        m_sweep_thread.join();
+    }
+}
+
+std::string SessionStore::create(int user_id, std::string_view username) {
+    return create(user_id, username, CoarseClock::now_seconds() + m_lifetime.count());
+}
+
+std::string SessionStore::create(int user_id, std::string_view username, std::int64_t expires_at) {
+    Handle handle;
+    handle.shard = m_next_shard.fetch_add(1, std::memory_order_relaxed) % kShards;
+    random_secret(handle.secret, kSecretSize);
+
+    Shard& shard = *m_shards[handle.shard];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.free.empty()) {
+            handle.index = shard.free.back();
+            shard.free.pop_back();
+        } else {
+            handle.index = static_cast<std::uint32_t>(shard.slots.size());
+            shard.slots.emplace_back();
+        }
+        Slot& slot = shard.slots[handle.index];
+        slot.user_id = user_id;
+        slot.username.assign(username.data(), username.size());
+        std::memcpy(slot.secret, handle.secret, kSecretSize);
+        handle.generation = slot.generation;
+        shard.wheel.schedule(handle.index, expires_at);
+        ++shard.live;
+    }
+    m_created.fetch_add(1, std::memory_order_relaxed);
+    return encode(handle);
+}
+
+std::optional<SessionStore::Renewal> SessionStore::refresh(std::string_view token) {
+    Handle handle;
+    if (!decode(token, handle)) {
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    unsigned char secret[kSecretSize];
+    random_secret(secret, kSecretSize);
+
+    const std::int64_t now = CoarseClock::now_seconds();
+    Renewal renewal;
+    Shard& shard = *m_shards[handle.shard];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Slot* slot = find(shard, handle, now);
+        if (!slot) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        std::memcpy(slot->secret, secret, kSecretSize);
+        renewal.user_id = slot->user_id;
+        renewal.username = slot->username;
+        renewal.expires_at = now + m_lifetime.count();
+        shard.wheel.schedule(handle.index, renewal.expires_at);
+    }
+
+    std::memcpy(handle.secret, secret, kSecretSize);
+    renewal.refresh_token = encode(handle);
+    m_refreshed.fetch_add(1, std::memory_order_relaxed);
+    return renewal;
+}
+
+bool SessionStore::revoke(std::string_view token) {
+    Handle handle;
+    if (!decode(token, handle)) {
+        return false;
+    }
+    Shard& shard = *m_shards[handle.shard];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!find(shard, handle, CoarseClock::now_seconds())) {
+        return false;
+    }
+    shard.wheel.cancel(handle.index);
+    release(shard, handle.index);
+    return true;
+}
+
+std::size_t SessionStore::sweep() {
+    return sweep(CoarseClock::now_seconds());
+}
+
+std::size_t SessionStore::sweep(std::int64_t now) {
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t expired = 0;
+    for (auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        expired += shard->wheel.advance(now, [&](TimerWheel::Id index) { release(*shard, index); });
+    }
+    const auto ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    m_expired.fetch_add(expired, std::memory_order_relaxed);
+    m_sweeps.fetch_add(1, std::memory_order_relaxed);
+    m_sweep_ns_total.fetch_add(ns, std::memory_order_relaxed);
+    std::uint64_t max = m_sweep_ns_max.load(std::memory_order_relaxed);
+    while (ns > max && !m_sweep_ns_max.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+    return expired;
+}
+
+void SessionStore::start_sweeper(std::chrono::seconds interval) {
+    std::lock_guard<std::mutex> lock(m_thread_mutex);
+    if (!m_sweep_thread.joinable()) {
+        m_sweep_thread = std::thread(&SessionStore::sweep_loop, this, interval);
+    }
+}
+
+std::size_t SessionStore::size() const {
+    std::size_t live = 0;
+    for (const auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        live += shard->live;
+    }
+    return live;
+}
+
+SessionStore::Stats SessionStore::stats() const {
+    Stats s;
+    for (const auto& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        s.sessions += shard->live;
+        s.memory_bytes += shard->slots.capacity() * sizeof(Slot) + shard->free.capacity() * sizeof(std::uint32_t) +
+                          shard->wheel.memory_bytes();
+    }
+    s.created = m_created.load(std::memory_order_relaxed);
+    s.refreshed = m_refreshed.load(std::memory_order_relaxed);
+    s.rejected = m_rejected.load(std::memory_order_relaxed);
+    s.expired = m_expired.load(std::memory_order_relaxed);
+    s.sweeps = m_sweeps.load(std::memory_order_relaxed);
+    s.sweep_ns_total = m_sweep_ns_total.load(std::memory_order_relaxed);
+    s.sweep_ns_max = m_sweep_ns_max.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::string SessionStore::encode(const Handle& handle) {
+    unsigned char raw[8 + kSecretSize];
+    put_u32(raw, handle.index * kShards + static_cast<std::uint32_t>(handle.shard));
+    put_u32(raw + 4, handle.generation);
+    std::memcpy(raw + 8, handle.secret, kSecretSize);
+
+    std::string token;
+    token.reserve(kTokenSize);
+    base64url_encode(raw, sizeof(raw), token);
+    return token;
+}
+
+bool SessionStore::decode(std::string_view token, Handle& handle) {
+    if (token.size() != kTokenSize) {
+        return false;
+    }
+    thread_local std::string raw;
+    raw.clear();
+    if (!base64url_decode(token, raw) || raw.size() != 8 + kSecretSize) {
+        return false;
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(raw.data());
+    const std::uint32_t slot_id = get_u32(bytes);
+    handle.shard = slot_id % kShards;
+    handle.index = slot_id / kShards;
+    handle.generation = get_u32(bytes + 4);
+    std::memcpy(handle.secret, bytes + 8, kSecretSize);
+    return true;
+}
+
+SessionStore::Slot* SessionStore::find(Shard& shard, const Handle& handle, std::int64_t now) {
+    if (handle.index >= shard.slots.size() || !shard.wheel.scheduled(handle.index)) {
+        return nullptr;
+    }
+    Slot& slot = shard.slots[handle.index];
+    if (slot.generation != handle.generation || CRYPTO_memcmp(slot.secret, handle.secret, kSecretSize) != 0) {
+        return nullptr;
+    }
+    // Vencida pero aún sin barrer: se trata como inexistente
+    if (shard.wheel.expires_at(handle.index) <= now) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+void SessionStore::release(Shard& shard, std::uint32_t index) {
+    Slot& slot = shard.slots[index];
+    ++slot.generation;
+    slot.user_id = 0;
+    slot.username.clear();
+    std::memset(slot.secret, 0, kSecretSize);
+    shard.free.push_back(index);
+    --shard.live;
+}
+
+void SessionStore::sweep_loop(std::chrono::seconds interval) {
+    std::unique_lock<std::mutex> lock(m_thread_mutex);
+    while (!m_stop_cv.wait_for(lock, interval, [this] { return m_stopping; })) {
+        lock.unlock();
+        const std::size_t expired = sweep();
+        if (expired) {
+            std::cout << "🧹 Sesiones: " << expired << " caducadas" << std::endl;
+        }
+        lock.lock();
+    }
+}
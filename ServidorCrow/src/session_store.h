@@ -0,0 +1,135 @@
+#pragma once
+
+#include "timer_wheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Sesiones de refresco: lo que permite pedir un token de acceso nuevo en
+// /refresh sin volver a enviar la password.
+//
+// El refresh token es opaco: 4 bytes de hueco, 4 de generación y 16 bytes
+// aleatorios (RAND_bytes) en base64url, 32 caracteres. El hueco indexa
+// directamente la tabla de su shard, así que validar un token es decodificar,
+// comparar generación y secreto (en tiempo constante) y mirar la expiración:
+// O(1), sin mapas ni hashes. Cada refresco rota el secreto (el token anterior
+// deja de valer) y alarga la sesión lifetime() desde ese momento.
+//
+// La caducidad la lleva una TimerWheel por shard: el barrido sólo toca las
+// sesiones que vencen, nunca recorre la tabla. Los huecos libres se reutilizan
+// con la generación incrementada, de modo que un token viejo no resucita.
+class SessionStore {
+public:
+    struct Renewal {
+        int user_id = 0;
+        std::string username;
+        std::string refresh_token;  // sustituye al que se presentó
+        std::int64_t expires_at = 0;
+    };
+
+    struct Stats {
+        std::size_t sessions = 0;
+        std::size_t memory_bytes = 0;  // tablas y ruedas (sin usernames de más de 15 bytes)
+        std::uint64_t created = 0;
+        std::uint64_t refreshed = 0;
+        std::uint64_t rejected = 0;
+        std::uint64_t expired = 0;
+        std::uint64_t sweeps = 0;
+        std::uint64_t sweep_ns_total = 0;
+        std::uint64_t sweep_ns_max = 0;
+    };
+
+    explicit SessionStore(std::chrono::seconds lifetime = std::chrono::hours{24 * 30});
+    ~SessionStore();
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // Abre una sesión que vence dentro de lifetime() y devuelve su refresh token
+    std::string create(int user_id, std::string_view username);
+
+    // Igual, con la expiración (segundos Unix) explícita
+    std::string create(int user_id, std::string_view username, std::int64_t expires_at);
+
+    // nullopt si el token no corresponde a una sesión viva
+    std::optional<Renewal> refresh(std::string_view token);
+
+    // Cierra la sesión del token; false si no estaba viva
+    bool revoke(std::string_view token);
+
+    // Caduca las sesiones vencidas hasta now (por defecto, el reloj actual)
+    std::size_t sweep();
+    std::size_t sweep(std::int64_t now);
+
+    // Lanza el hilo que llama a sweep() cada `interval`
+    void start_sweeper(std::chrono::seconds interval);
+
+    std::size_t size() const;
+    Stats stats() const;
+    std::chrono::seconds lifetime() const { return m_lifetime; }
+
+    static constexpr std::size_t kTokenSize = 32;
+
+private:
+    static constexpr std::size_t kShards = 16;
+    static constexpr std::size_t kSecretSize = 16;
+
+    struct Slot {
+        std::uint32_t generation = 0;
+        int user_id = 0;
+        unsigned char secret[kSecretSize] = {};
+        std::string username;
+    };
+
+    struct alignas(64) Shard {
+        explicit Shard(std::int64_t start) : wheel(start) {}
+
+        std::mutex mutex;
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> free;
+        TimerWheel wheel;  // ids = índices de slots
+        std::size_t live = 0;
+    };
+
+    struct Handle {
+        std::size_t shard;
+        std::uint32_t index;
+        std::uint32_t generation;
+        unsigned char secret[kSecretSize];
+    };
+
+    static std::string encode(const Handle& handle);
+    static bool decode(std::string_view token, Handle& handle);
+
+    // Slot vivo que corresponde al token (con el lock del shard tomado) o nullptr
+    Slot* find(Shard& shard, const Handle& handle, std::int64_t now);
+    void release(Shard& shard, std::uint32_t index);
+    void sweep_loop(std::chrono::seconds interval);
+
+    const std::chrono::seconds m_lifetime;
+    std::unique_ptr<Shard> m_shards[kShards];
+    std::atomic<std::size_t> m_next_shard{0};
+
+    std::atomic<std::uint64_t> m_created{0};
+    std::atomic<std::uint64_t> m_refreshed{0};
+    std::atomic<std::uint64_t> m_rejected{0};
+    std::atomic<std::uint64_t> m_expired{0};
+    std::atomic<std::uint64_t> m_sweeps{0};
+    std::atomic<std::uint64_t> m_sweep_ns_total{0};
+    std::atomic<std::uint64_t> m_sweep_ns_max{0};
+
+    std::mutex m_thread_mutex;
+    std::condition_variable m_stop_cv;
+    bool m_stopping = false;
+    std::thread m_sweep_thread;
+};
@@ -0,0 +1,110 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <iterator>
+
+TimerWheel::TimerWheel(std::int64_t start) : m_now(start) {
+    std::fill(std::begin(m_heads), std::end(m_heads), kNone);
+}
+
+void TimerWheel::schedule(Id id, std::int64_t expires_at) {
+    if (id >= m_nodes.size()) {
+        m_nodes.resize(static_cast<std::size_t>(id) + 1);
+    } else if (m_nodes[id].bucket != kUnscheduled) {
+        unlink(id);
+    }
+    m_nodes[id].expires_at = expires_at;
+    link(id);
+}
+
+void TimerWheel::cancel(Id id) {
+    if (scheduled(id)) {
+        unlink(id);
+    }
+}
+
+bool TimerWheel::scheduled(Id id) const {
+    return id < m_nodes.size() && m_nodes[id].bucket != kUnscheduled;
+}
+
+std::size_t TimerWheel::advance(std::int64_t now, const std::function<void(Id)>& on_expire) {
+    std::size_t expired = 0;
+    for (; m_now <= now; ++m_now) {
+        // Al empezar un bloque de 64^l segundos se baja la casilla del nivel l
+        // que le corresponde, empezando por el nivel más alto
+        for (int level = kLevels - 1; level > 0; --level) {
+            if ((m_now & ((std::int64_t{1} << (kSlotBits * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+
+        // En el nivel 0 la casilla de m_now sólo contiene lo que vence en m_now
+        Id& head = m_heads[m_now & (kSlots - 1)];
+        Id id = head;
+        head = kNone;
+        while (id != kNone) {
+            Node& node = m_nodes[id];
+            const Id next = node.next;
+            node.bucket = kUnscheduled;
+            node.next = node.prev = kNone;
+            on_expire(id);
+            ++expired;
+            id = next;
+        }
+    }
+    return expired;
+}
+
+std::size_t TimerWheel::memory_bytes() const {
+    return m_nodes.capacity() * sizeof(Node) + sizeof(m_heads);
+}
+
+void TimerWheel::link(Id id) {
+    Node& node = m_nodes[id];
+    std::int64_t t = std::max(node.expires_at, m_now);
+
+    // Nivel: el primero cuyo alcance (64^(l+1) s) cubre lo que falta. Más
+    // allá del último se aparca al final de su alcance y se reubica al bajar.
+    int level = 0;
+    while (level < kLevels - 1 && t - m_now >= (std::int64_t{1} << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+    const std::int64_t horizon = m_now + (std::int64_t{1} << (kSlotBits * kLevels)) - 1;
+    t = std::min(t, horizon);
+
+    const auto bucket = static_cast<std::uint16_t>(level * kSlots + ((t >> (kSlotBits * level)) & (kSlots - 1)));
+    node.bucket = bucket;
+    node.prev = kNone;
+    node.next = m_heads[bucket];
+    if (node.next != kNone) {
+        m_nodes[node.next].prev = id;
+    }
+    m_heads[bucket] = id;
+}
+
+void TimerWheel::unlink(Id id) {
+    Node& node = m_nodes[id];
+    if (node.prev != kNone) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[node.bucket] = node.next;
+    }
+    if (node.next != kNone) {
+        m_nodes[node.next].prev = node.prev;
+    }
+    node.bucket = kUnscheduled;
+    node.next = node.prev = kNone;
+}
+
+void TimerWheel::cascade(int level) {
+    // Se separa la lista entera antes de reubicar: un nodo puede volver a
+    // caer en la misma casilla si sigue lejos
+    Id& head = m_heads[level * kSlots + ((m_now >> (kSlotBits * level)) & (kSlots - 1))];
+    Id id = head;
+    head = kNone;
+    while (id != kNone) {
+        const Id next = m_nodes[id].next;
+        link(id);
+        id = next;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Rueda de temporizadores jerárquica (Varghese y Lauck) con resolución de 1 s.
+//
+// Cuatro niveles de 64 casillas cubren 64 s, ~68 min, ~3 días y ~194 días;
+// lo que caduca más tarde espera en el último nivel. Programar, reprogramar y
+// cancelar son O(1): cada temporizador es un nodo de una lista doblemente
+// enlazada intrusiva, indexado por un id denso que elige el dueño (p. ej. el
+// hueco de una sesión). Avanzar un segundo sólo toca la casilla que vence; cada
+// 64 s se redistribuye una casilla del nivel superior, así que el coste de
+// caducar es proporcional a lo que caduca, no a lo que hay programado.
+//
+// No es segura entre hilos: la protege su dueño.
+class TimerWheel {
+public:
+    using Id = std::uint32_t;
+
+    // start: segundo (Unix) desde el que empieza a girar
+    explicit TimerWheel(std::int64_t start);
+
+    // Programa (o reprograma) id para el segundo expires_at. Lo que ya ha
+    // vencido caduca en el primer segundo que aún no se ha procesado.
+    void schedule(Id id, std::int64_t expires_at);
+
+    void cancel(Id id);
+
+    bool scheduled(Id id) const;
+
+    // Segundo de expiración de un id programado
+    std::int64_t expires_at(Id id) const { return m_nodes[id].expires_at; }
+
+    // Gira hasta `now` (incluido) y llama a on_expire con cada id vencido, que
+    // ya no está programado cuando se le llama (on_expire no debe tocar otros
+    // temporizadores). Devuelve cuántos caducaron.
+    std::size_t advance(std::int64_t now, const std::function<void(Id)>& on_expire);
+
+    // Ids con nodo reservado (programados o no) y bytes de la estructura
+    std::size_t capacity() const { return m_nodes.size(); }
+    std::size_t memory_bytes() const;
+
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+
+private:
+    static constexpr Id kNone = UINT32_MAX;
+    static constexpr std::uint16_t kUnscheduled = UINT16_MAX;
+
+    struct Node {
+        std::int64_t expires_at = 0;
+        Id next = kNone;
+        Id prev = kNone;
+        std::uint16_t bucket = kUnscheduled;
+    };
+
+    void link(Id id);
+    void unlink(Id id);
+    void cascade(int level);
+
+    std::vector<Node> m_nodes;
+    Id m_heads[kLevels * kSlots];
+    std::int64_t m_now;  // siguiente segundo por procesar
+};
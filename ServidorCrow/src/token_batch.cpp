@@ -0,0 +1,131 @@
+#include "token_batch.h"
+
+#include "json_writer.h"
+
+#include <numeric>
+
+namespace {
+
+class Scanner {
+public:
+    explicit Scanner(std::string_view text) : m_text(text) {}
+
+    bool eat(char c) {
+        skip_spaces();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    // String sin escapes, sin caracteres de control y en ASCII (lo demás,
+    // a nlohmann, que además valida el UTF-8)
+    bool plain_string(std::string_view& out) {
+        if (!eat('"')) {
+            return false;
+        }
+        const std::size_t begin = m_pos;
+        for (; m_pos < m_text.size(); ++m_pos) {
+            const auto c = static_cast<unsigned char>(m_text[m_pos]);
+            if (c == '"') {
+                out = m_text.substr(begin, m_pos++ - begin);
+                return true;
+            }
+            if (c == '\\' || c < 0x20 || c >= 0x80) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool at_end() {
+        skip_spaces();
+        return m_pos == m_text.size();
+    }
+
+private:
+    void skip_spaces() {
+        while (m_pos < m_text.size() &&
+               (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+            ++m_pos;
+        }
+    }
+
+    std::string_view m_text;
+    std::size_t m_pos = 0;
+};
+
+}  // namespace
+
+bool parse_token_batch(std::string_view body, std::vector<std::string_view>& tokens) {
+    tokens.clear();
+    Scanner scanner(body);
+    std::string_view key;
+    if (!scanner.eat('{') || !scanner.plain_string(key) || key != "tokens" || !scanner.eat(':') ||
+        !scanner.eat('[')) {
+        return false;
+    }
+    if (!scanner.eat(']')) {
+        do {
+            std::string_view token;
+            if (!scanner.plain_string(token)) {
+                return false;
+            }
+            tokens.push_back(token);
+        } while (scanner.eat(','));
+        if (!scanner.eat(']')) {
+            return false;
+        }
+    }
+    return scanner.eat('}') && scanner.at_end();
+}
+
+std::string verify_token_batch(const TokenVerifier& verifier, WorkerPool& pool,
+                               const std::vector<std::string_view>& tokens) {
+    const std::size_t chunks = (tokens.size() + kTokenBatchGrain - 1) / kTokenBatchGrain;
+    std::vector<std::string> parts(chunks);
+    std::vector<std::size_t> valid(chunks);
+
+    pool.parallel_for(tokens.size(), kTokenBatchGrain, [&](std::size_t begin, std::size_t end) {
+        const std::size_t chunk = begin / kTokenBatchGrain;
+        // Elementos en el orden de claves de nlohmann:
+        //   {"exp":N,"user":{"id":1,"username":"juan"},"valid":true}
+        //   {"error":"Token expirado","valid":false}
+        JsonWriter out((end - begin) * 96);
+        for (std::size_t i = begin; i < end; ++i) {
+            const TokenVerifier::Result result = verifier.verify(tokens[i]);
+            out.begin_object();
+            if (result) {
+                out.key("exp").value(result.claims->expires_at)
+                    .key("user").begin_object()
+                        .key("id").value(result.claims->user_id)
+                        .key("username").value(result.claims->username)
+                    .end_object();
+                ++valid[chunk];
+            } else {
+                out.key("error").value(TokenVerifier::describe(result.status));
+            }
+            out.key("valid").value(static_cast<bool>(result)).end_object();
+        }
+        parts[chunk] = out.take();
+    });
+
+    std::size_t size = 64;
+    for (const auto& part : parts) {
+        size += part.size() + 1;
+    }
+    std::string body;
+    body.reserve(size);
+    body += R"({"results":[)";
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (chunk) {
+            body += ',';
+        }
+        body += parts[chunk];
+    }
+    body += R"(],"success":true,"valid":)";
+    body += std::to_string(std::accumulate(valid.begin(), valid.end(), std::size_t{0}));
+    body += '}';
+    return body;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "token_verifier.h"
+#include "worker_pool.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Verificación por lotes de POST /verify/batch (el gateway valida muchos
+// tokens en una sola petición).
+//
+// Lee {"tokens": ["<jwt>", ...]} sin construir un DOM: los tokens son vistas
+// sobre el body. Sólo acepta esa forma exacta y strings sin escapes (un JWT es
+// base64url y puntos); con cualquier otra cosa devuelve false y el handler
+// recurre a nlohmann, que da el mismo resultado o el error de siempre.
+bool parse_token_batch(std::string_view body, std::vector<std::string_view>& tokens);
+
+// Verifica el lote repartido entre los hilos del pool, en bloques de
+// kTokenBatchGrain tokens. Cada bloque verifica (con la caché del verifier) y
+// serializa sus resultados, así que también la respuesta escala con los
+// núcleos. Devuelve el body JSON con las claves en el orden de nlohmann:
+//
+//   {"results":[{"exp":N,"user":{"id":1,"username":"juan"},"valid":true},
+//               {"error":"Token expirado","valid":false}],"success":true,"valid":1}
+std::string verify_token_batch(const TokenVerifier& verifier, WorkerPool& pool,
+                               const std::vector<std::string_view>& tokens);
+
+constexpr std::size_t kTokenBatchGrain = 256;
@@ -0,0 +1,106 @@
+#include "token_service.h"
+
+#include "base64url.h"
+#include "coarse_clock.h"
+
+#include <openssl/rand.h>
+
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+void append_int(std::string& out, std::int64_t value) {
+    char digits[24];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// Escapado de cadenas de picojson: además de lo obligatorio escapa '/' y 0x7f
+void append_json_string(std::string& out, std::string_view value) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '/': out += "\\/"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                const auto byte = static_cast<unsigned char>(c);
+                if (byte < 0x20 || byte == 0x7f) {
+                    const char escaped[] = {'\\', 'u', '0', '0', kHex[byte >> 4], kHex[byte & 15]};
+                    out.append(escaped, sizeof(escaped));
+                } else {
+                    out += c;
+                }
+            }
+        }
+    }
+    out += '"';
+}
+
+// Identificador único del token: 128 bits de RAND_bytes, que no se pueden
+// predecir a partir de jti ya vistos. Como en session_store.cpp, se sirven
+// desde un bloque por hilo: una llamada a OpenSSL cada 256 tokens.
+std::string_view next_jti(char (&buffer)[24]) {
+    thread_local unsigned char pool[4096];
+    thread_local std::size_t used = sizeof(pool);
+    unsigned char bits[16];
+    if (used + sizeof(bits) > sizeof(pool)) {
+        if (RAND_bytes(pool, static_cast<int>(sizeof(pool))) != 1) {
+            throw std::runtime_error("RAND_bytes falló generando un jti");
+        }
+        used = 0;
+    }
+    std::memcpy(bits, pool + used, sizeof(bits));
+    used += sizeof(bits);
+    const char* end = base64url_encode(bits, sizeof(bits), buffer);
+    return std::string_view(buffer, static_cast<std::size_t>(end - buffer));
+}
+
+}  // namespace
+
+TokenService::TokenService(const std::vector<KeyRing::Spec>& keys, std::chrono::seconds lifetime)
+    : m_keys(keys), m_lifetime(lifetime) {}
+
+std::string TokenService::issue(int user_id, std::string_view username) const {
+    char jti[24];
+    return issue(user_id, username, CoarseClock::now_seconds() + m_lifetime.count(), next_jti(jti));
+}
+
+std::string TokenService::issue(int user_id, std::string_view username, std::int64_t expires_at,
+                                std::string_view jti) const {
+    // El buffer del payload conserva su capacidad entre peticiones del hilo
+    thread_local std::string payload;
+    payload.clear();
+    payload += R"({"exp":)";
+    append_int(payload, expires_at);
+    payload += R"(,"iss":")";
+    payload += kIssuer;
+    payload += R"(","jti":)";
+    append_json_string(payload, jti);
+    payload += R"(,"user_id":")";
+    append_int(payload, user_id);
+    payload += R"(","username":)";
+    append_json_string(payload, username);
+    payload += '}';
+
+    const KeyRing::Key& key = *m_keys.current().active;
+    std::string token;
+    token.reserve(key.header.size() + base64url_encoded_size(payload.size()) + 1 +
+                  base64url_encoded_size(key.signer->signature_size()));
+    token += key.header;
+    base64url_encode(payload.data(), payload.size(), token);
+
+    unsigned char signature[TokenSigner::kMaxSignatureSize];
+    key.signer->sign(token.data(), token.size(), signature);
+    token += '.';
+    base64url_encode(signature, key.signer->signature_size(), token);
+    return token;
+}
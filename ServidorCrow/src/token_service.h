@@ -0,0 +1,49 @@
+#pragma once
+
+#include "key_ring.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Emisión de los tokens JWT de /register y /login.
+//
+// Es dueño de las claves (KeyRing, con el estado HMAC precalculado por hilo),
+// así que los handlers comparten un único objeto en lugar de construir
+// jwt::algorithm::hs256 en cada petición. Firma con la clave activa, que
+// puede ser HS256, ES256 o EdDSA.
+//
+// El header sólo depende de la clave y se codifica una vez; el payload se escribe
+// en un buffer por hilo con las claves en el orden en que las serializa
+// jwt-cpp (picojson, std::map ordenado) y con su mismo escapado, así que los
+// tokens son idénticos byte a byte a los de jwt::create():
+//
+//   {"alg":"<alg>","kid":"<kid>","typ":"JWS"}
+//   {"exp":N,"iss":"auth.transmi","jti":"<id>","user_id":"<id>","username":"<username>"}
+//
+// El jti son 128 bits de RAND_bytes en base64url (22 caracteres); identifica
+// el token para poder revocarlo.
+class TokenService {
+public:
+    explicit TokenService(const std::vector<KeyRing::Spec>& keys,
+                          std::chrono::seconds lifetime = std::chrono::hours{24});
+
+    // Token firmado para el usuario, válido durante lifetime() desde ahora
+    std::string issue(int user_id, std::string_view username) const;
+
+    // Igual, con exp (segundos Unix) y jti explícitos
+    std::string issue(int user_id, std::string_view username, std::int64_t expires_at,
+                      std::string_view jti) const;
+
+    KeyRing& keys() { return m_keys; }
+    const KeyRing& keys() const { return m_keys; }
+    std::chrono::seconds lifetime() const { return m_lifetime; }
+
+    static constexpr const char* kIssuer = "auth.transmi";
+
+private:
+    KeyRing m_keys;
+    std::chrono::seconds m_lifetime;
+};
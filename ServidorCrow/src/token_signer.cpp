@@ -0,0 +1,27 @@
+#include "token_signer.h"
+
+#include <stdexcept>
+
+std::string TokenSigner::sign(const std::string& data, std::error_code& ec) const {
+    ec.clear();
+    std::string signature(signature_size(), '\0');
+    try {
+        sign(data.data(), data.size(), reinterpret_cast<unsigned char*>(&signature[0]));
+    } catch (const std::runtime_error&) {
+        ec = std::make_error_code(std::errc::protocol_error);
+        return {};
+    }
+    return signature;
+}
+
+void TokenSigner::verify(const std::string& data, const std::string& signature, std::error_code& ec) const {
+    ec.clear();
+    try {
+        if (!verify(data.data(), data.size(), reinterpret_cast<const unsigned char*>(signature.data()),
+                    signature.size())) {
+            ec = std::make_error_code(std::errc::permission_denied);
+        }
+    } catch (const std::runtime_error&) {
+        ec = std::make_error_code(std::errc::protocol_error);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+// Algoritmo de firma de los tokens (HS256, ES256, EdDSA) con su clave.
+//
+// Trabaja con firmas binarias en el formato de JWS: el HMAC de 32 bytes, r||s
+// de 64 bytes para ES256 y los 64 bytes de Ed25519. También expone la
+// interfaz de algoritmo de jwt-cpp (name/sign/verify con std::string), así
+// que cualquier firmante puede pasarse a jwt::create().sign(...) y a
+// jwt::verify().allow_algorithm(...).
+class TokenSigner {
+public:
+    static constexpr std::size_t kMaxSignatureSize = 64;
+
+    virtual ~TokenSigner() = default;
+
+    // Nombre JWS del algoritmo ("alg" del header)
+    virtual const char* alg() const = 0;
+
+    virtual std::size_t signature_size() const = 0;
+
+    // Escribe signature_size() bytes de firma de data en out
+    virtual void sign(const void* data, std::size_t size, unsigned char* out) const = 0;
+
+    virtual bool verify(const void* data, std::size_t size, const unsigned char* signature,
+                        std::size_t signature_size) const = 0;
+
+    // Miembros JSON de la clave pública para el JWKS ("kty", "crv", "x", ...),
+    // sin llaves; vacío si la clave es simétrica y no se publica
+    virtual std::string public_jwk_members() const { return {}; }
+
+    // Interfaz de jwt-cpp
+    std::string sign(const std::string& data, std::error_code& ec) const;
+    void verify(const std::string& data, const std::string& signature, std::error_code& ec) const;
+    std::string name() const { return alg(); }
+};
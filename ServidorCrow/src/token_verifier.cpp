@@ -0,0 +1,239 @@
+#include "token_verifier.h"
+
+#include "base64url.h"
+#include "coarse_clock.h"
+#include "token_service.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <functional>
+
+namespace {
+
+std::atomic<std::uint64_t> g_next_instance{1};
+std::atomic<std::size_t> g_next_thread{0};
+
+std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
+// Caché de un hilo, válida para un único TokenVerifier (el último que la usó)
+struct TokenVerifier::ThreadCache {
+    std::uint64_t instance = 0;
+    std::size_t stripe = g_next_thread.fetch_add(1, std::memory_order_relaxed) % kCounterStripes;
+    Entry entries[kThreadEntries];
+};
+
+TokenVerifier::TokenVerifier(const KeyRing& keys, std::size_t capacity, const RevocationList* revocations)
+    : m_keys(keys), m_revocations(revocations), m_instance(g_next_instance.fetch_add(1)) {
+    std::size_t sets = 1;
+    while (sets * kWays < capacity) {
+        sets <<= 1;
+    }
+    m_set_mask = sets - 1;
+    m_sets = std::make_unique<CacheSet[]>(sets);
+}
+
+TokenVerifier::Result TokenVerifier::verify(std::string_view token) const {
+    const auto start = std::chrono::steady_clock::now();
+    const std::int64_t now = CoarseClock::now_seconds();
+    const std::uint64_t digest = std::hash<std::string_view>{}(token);
+    const KeyRing::Keys& keys = m_keys.current();
+
+    ThreadCache& local = thread_cache();
+    Entry& slot = local.entries[digest & (kThreadEntries - 1)];
+    if (slot.claims && slot.digest == digest && slot.token == token) {
+        if (slot.expires_at > now && slot.keys_version == keys.version) {
+            Result result{Status::Valid, slot.claims};
+            if (is_revoked(*result.claims)) {
+                result = Result{Status::Revoked, nullptr};
+                m_rejected.fetch_add(1, std::memory_order_relaxed);
+            }
+            HitCounter& counter = m_thread_hits[local.stripe];
+            counter.hits.fetch_add(1, std::memory_order_relaxed);
+            counter.ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+            return result;
+        }
+        slot.claims.reset();
+    }
+
+    // Los válidos pasan a la caché del hilo con una copia propia de los claims
+    auto remember = [&](const std::shared_ptr<const TokenClaims>& claims) {
+        slot.digest = digest;
+        slot.expires_at = claims->expires_at;
+        slot.keys_version = keys.version;
+        slot.token.assign(token.data(), token.size());
+        slot.claims = std::make_shared<const TokenClaims>(*claims);
+    };
+
+    if (auto claims = cache_lookup(digest, token, keys.version, now)) {
+        remember(claims);
+        Result result{Status::Valid, std::move(claims)};
+        if (is_revoked(*result.claims)) {
+            result = Result{Status::Revoked, nullptr};
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        m_hit_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+        return result;
+    }
+
+    Result result = verify_uncached(token, keys, now);
+    if (result) {
+        cache_insert(digest, token, keys.version, result.claims);
+        remember(result.claims);
+        if (is_revoked(*result.claims)) {
+            result = Result{Status::Revoked, nullptr};
+        }
+    }
+    if (!result) {
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    m_verify_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+    return result;
+}
+
+TokenVerifier::Stats TokenVerifier::stats() const {
+    Stats s;
+    s.hits = m_hits.load(std::memory_order_relaxed);
+    s.hit_ns_total = m_hit_ns.load(std::memory_order_relaxed);
+    for (const HitCounter& counter : m_thread_hits) {
+        s.thread_hits += counter.hits.load(std::memory_order_relaxed);
+        s.hit_ns_total += counter.ns.load(std::memory_order_relaxed);
+    }
+    s.hits += s.thread_hits;
+    s.misses = m_misses.load(std::memory_order_relaxed);
+    s.rejected = m_rejected.load(std::memory_order_relaxed);
+    s.verify_ns_total = m_verify_ns.load(std::memory_order_relaxed);
+    s.capacity = (m_set_mask + 1) * kWays;
+    return s;
+}
+
+const char* TokenVerifier::describe(Status status) {
+    switch (status) {
+        case Status::Valid: return "Token válido";
+        case Status::Malformed: return "Token mal formado";
+        case Status::BadSignature: return "Firma del token inválida";
+        case Status::Expired: return "Token expirado";
+        case Status::Revoked: return "Token revocado";
+        case Status::UnknownKey: return "Clave de firma desconocida";
+    }
+    return "Token inválido";
+}
+
+TokenVerifier::ThreadCache& TokenVerifier::thread_cache() const {
+    thread_local ThreadCache cache;
+    if (cache.instance != m_instance) {
+        for (Entry& entry : cache.entries) {
+            entry.claims.reset();
+        }
+        cache.instance = m_instance;
+    }
+    return cache;
+}
+
+bool TokenVerifier::is_revoked(const TokenClaims& claims) const {
+    return m_revocations && !claims.jti.empty() && m_revocations->is_revoked(claims.jti);
+}
+
+std::shared_ptr<const TokenClaims> TokenVerifier::cache_lookup(std::uint64_t digest, std::string_view token,
+                                                               std::uint64_t keys_version, std::int64_t now) const {
+    CacheSet& set = m_sets[digest & m_set_mask];
+    std::lock_guard<std::mutex> lock(set.mutex);
+    for (Entry& entry : set.ways) {
+        if (entry.digest == digest && entry.claims && entry.token == token) {
+            if (entry.expires_at > now && entry.keys_version == keys_version) {
+                return entry.claims;
+            }
+            entry.claims.reset();  // caducado o claves recargadas: verificación completa
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void TokenVerifier::cache_insert(std::uint64_t digest, std::string_view token, std::uint64_t keys_version,
+                                 const std::shared_ptr<const TokenClaims>& claims) const {
+    CacheSet& set = m_sets[digest & m_set_mask];
+    std::lock_guard<std::mutex> lock(set.mutex);
+
+    // Hueco libre o caducado; si no hay, una vía elegida por el hash (un
+    // reemplazo circular vaciaría el conjunto entero ante un recorrido cíclico)
+    const std::int64_t now = CoarseClock::now_seconds();
+    Entry* victim = nullptr;
+    for (Entry& entry : set.ways) {
+        if (!entry.claims || entry.expires_at <= now || (entry.digest == digest && entry.token == token)) {
+            victim = &entry;
+            break;
+        }
+    }
+    if (!victim) {
+        victim = &set.ways[(digest >> 32) % kWays];
+    }
+    victim->digest = digest;
+    victim->expires_at = claims->expires_at;
+    victim->keys_version = keys_version;
+    victim->token.assign(token.data(), token.size());
+    victim->claims = claims;
+}
+
+TokenVerifier::Result TokenVerifier::verify_uncached(std::string_view token, const KeyRing::Keys& keys,
+                                                     std::int64_t now) const {
+    const std::size_t first = token.find('.');
+    const std::size_t second = first == std::string_view::npos ? first : token.find('.', first + 1);
+    if (second == std::string_view::npos || token.find('.', second + 1) != std::string_view::npos) {
+        return Result{Status::Malformed, nullptr};
+    }
+
+    std::string header, payload, signature;
+    if (!base64url_decode(token.substr(0, first), header) ||
+        !base64url_decode(token.substr(first + 1, second - first - 1), payload)) {
+        return Result{Status::Malformed, nullptr};
+    }
+    if (!base64url_decode(token.substr(second + 1), signature)) {
+        return Result{Status::BadSignature, nullptr};
+    }
+
+    try {
+        // El header elige la clave; sin kid, la de los tokens anteriores a la rotación
+        const auto h = nlohmann::json::parse(header);
+        const auto kid = h.find("kid");
+        const KeyRing::Key* key =
+            keys.find(kid == h.end() ? std::string(KeyRing::kDefaultKid) : kid->get<std::string>());
+        if (!key) {
+            return Result{Status::UnknownKey, nullptr};
+        }
+        // El alg lo fija la clave, nunca el token (evita la confusión HS256/RS256 y "none")
+        if (h.at("alg") != key->signer->alg()) {
+            return Result{Status::Malformed, nullptr};
+        }
+
+        if (!key->signer->verify(token.data(), second, reinterpret_cast<const unsigned char*>(signature.data()),
+                                 signature.size())) {
+            return Result{Status::BadSignature, nullptr};
+        }
+
+        const auto p = nlohmann::json::parse(payload);
+        if (p.at("iss") != TokenService::kIssuer) {
+            return Result{Status::Malformed, nullptr};
+        }
+        auto claims = std::make_shared<TokenClaims>();
+        claims->expires_at = p.at("exp").get<std::int64_t>();
+        claims->user_id = std::stoi(p.at("user_id").get<std::string>());
+        claims->username = p.at("username").get<std::string>();
+        if (auto jti = p.find("jti"); jti != p.end()) {
+            claims->jti = jti->get<std::string>();
+        }
+        if (claims->expires_at <= now) {
+            return Result{Status::Expired, nullptr};
+        }
+        return Result{Status::Valid, std::move(claims)};
+    } catch (const std::exception&) {
+        return Result{Status::Malformed, nullptr};
+    }
+}
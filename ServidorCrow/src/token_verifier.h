@@ -0,0 +1,126 @@
+#pragma once
+
+#include "key_ring.h"
+#include "revocation_list.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Claims de un token emitido por TokenService
+struct TokenClaims {
+    int user_id;
+    std::string username;
+    std::int64_t expires_at;  // segundos Unix
+    std::string jti;          // vacío en tokens anteriores al jti (no revocables)
+};
+
+// Validación de los tokens del servidor con caché de tokens verificados.
+//
+// Un fallo de caché hace el trabajo completo: separar las tres partes, elegir
+// la clave por el kid del header, verificar la firma del header.payload
+// (HMAC con comparación en tiempo constante, ECDSA o Ed25519), decodificar el
+// payload y comprobar iss/exp. Los tokens válidos se guardan con sus claims
+// hasta su exp, así que las peticiones repetidas de una misma sesión sólo
+// cuestan un hash del token y una comparación de bytes, sin criptografía.
+//
+// La caché es acotada y asociativa por conjuntos: el hash del token elige un
+// conjunto de kWays entradas, cada uno con su propio mutex. Cada entrada
+// guarda el token completo, así que una colisión de hash nunca da por bueno
+// un token distinto. Las entradas recuerdan la versión del KeyRing con la
+// que se verificaron: tras recargar las claves se vuelven a verificar (así
+// una clave retirada deja de aceptarse al momento).
+//
+// Delante de la caché compartida hay otra pequeña por hilo (kThreadEntries,
+// de acceso directo) con su propia copia de los claims: una conexión
+// keep-alive la atiende siempre el mismo hilo de Crow, así que las peticiones
+// repetidas se resuelven sin locks y sin escribir memoria compartida: los
+// claims tienen su propio contador de referencias y los aciertos se cuentan
+// en una línea de caché por hilo.
+//
+// Con una RevocationList, cada token válido (de la caché o no) se comprueba
+// además contra los revocados; el caso común es una lectura del filtro de Bloom.
+class TokenVerifier {
+public:
+    enum class Status { Valid, Malformed, BadSignature, Expired, Revoked, UnknownKey };
+
+    struct Result {
+        Status status;
+        std::shared_ptr<const TokenClaims> claims;  // sólo si status == Valid
+
+        explicit operator bool() const { return status == Status::Valid; }
+    };
+
+    struct Stats {
+        std::uint64_t hits = 0;            // válidos servidos desde la caché (de cualquier nivel)
+        std::uint64_t thread_hits = 0;     // ... de ellos, desde la caché del hilo
+        std::uint64_t misses = 0;          // tokens verificados por completo
+        std::uint64_t rejected = 0;        // inválidos, caducados o revocados
+        std::uint64_t hit_ns_total = 0;
+        std::uint64_t verify_ns_total = 0; // fallos de caché (válidos o no)
+        std::size_t capacity = 0;
+    };
+
+    static constexpr std::size_t kWays = 4;
+    static constexpr std::size_t kThreadEntries = 64;
+
+    // capacity: número máximo de tokens en caché (se redondea a potencia de 2)
+    explicit TokenVerifier(const KeyRing& keys, std::size_t capacity = 1 << 16,
+                           const RevocationList* revocations = nullptr);
+
+    Result verify(std::string_view token) const;
+
+    Stats stats() const;
+
+    // Texto del error para las respuestas 401
+    static const char* describe(Status status);
+
+private:
+    struct Entry {
+        std::uint64_t digest = 0;
+        std::int64_t expires_at = 0;
+        std::uint64_t keys_version = 0;
+        std::string token;
+        std::shared_ptr<const TokenClaims> claims;
+    };
+
+    struct alignas(64) CacheSet {
+        std::mutex mutex;
+        Entry ways[kWays];
+    };
+
+    struct ThreadCache;
+
+    // Contadores de aciertos de la caché por hilo, uno por línea de caché
+    struct alignas(64) HitCounter {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> ns{0};
+    };
+    static constexpr std::size_t kCounterStripes = 64;
+
+    ThreadCache& thread_cache() const;
+
+    std::shared_ptr<const TokenClaims> cache_lookup(std::uint64_t digest, std::string_view token,
+                                                    std::uint64_t keys_version, std::int64_t now) const;
+    void cache_insert(std::uint64_t digest, std::string_view token, std::uint64_t keys_version,
+                      const std::shared_ptr<const TokenClaims>& claims) const;
+    Result verify_uncached(std::string_view token, const KeyRing::Keys& keys, std::int64_t now) const;
+    bool is_revoked(const TokenClaims& claims) const;
+
+    const KeyRing& m_keys;
+    const RevocationList* m_revocations;
+    const std::uint64_t m_instance;
+    std::size_t m_set_mask;
+    std::unique_ptr<CacheSet[]> m_sets;
+
+    mutable std::atomic<std::uint64_t> m_hits{0};
+    mutable std::atomic<std::uint64_t> m_misses{0};
+    mutable std::atomic<std::uint64_t> m_rejected{0};
+    mutable std::atomic<std::uint64_t> m_hit_ns{0};
+    mutable std::atomic<std::uint64_t> m_verify_ns{0};
+    mutable HitCounter m_thread_hits[kCounterStripes];
+};
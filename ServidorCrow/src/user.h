@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+// Estructura simple para almacenar usuarios en memoria
+struct User {
+    std::string username;
+    std::string password;  // En la vida real, esto debería estar hasheado
+    int id;
+};
@@ -0,0 +1,175 @@
+#include "user_list_stream.h"
+
+#include "json_writer.h"
+#include "raw_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+UserListStream::UserListStream(const UserStore& store, std::size_t page_size)
+    : m_store(store), m_page_size(std::max<std::size_t>(page_size, 1)) {}
+
+std::string_view UserListStream::next() {
+    m_chunk.clear();
+    switch (m_state) {
+        case State::Head:
+            m_chunk = R"({"success":true,"users":[)";
+            m_state = State::Users;
+            return m_chunk;
+        case State::Users: {
+            const std::vector<User> users = m_store.page(m_last_id, m_page_size);
+            if (users.empty()) {
+                m_chunk = "]}";
+                m_state = State::Done;
+                return m_chunk;
+            }
+            // Misma forma que users_response(); la coma va delante salvo en el primero
+            for (const User& user : users) {
+                if (!m_first) {
+                    m_chunk += ',';
+                }
+                m_first = false;
+                char digits[16];
+                const char* end = std::to_chars(digits, digits + sizeof(digits), user.id).ptr;
+                m_chunk += R"({"id":)";
+                m_chunk.append(digits, static_cast<std::size_t>(end - digits));
+                m_chunk += R"(,"username":")";
+                JsonWriter::append_escaped(m_chunk, user.username);
+                m_chunk += "\"}";
+                m_last_id = user.id;
+            }
+            return m_chunk;
+        }
+        case State::Done: break;
+    }
+    return {};
+}
+
+UserListSpool::Entry::Entry(Entry&& other) noexcept
+    : m_spool(other.m_spool), m_path(std::move(other.m_path)), m_bytes(other.m_bytes),
+      m_too_large(other.m_too_large) {
+    other.m_spool = nullptr;
+}
+
+UserListSpool::Entry& UserListSpool::Entry::operator=(Entry&& other) noexcept {
+    if (this != &other) {
+        if (m_spool) {
+            m_spool->release(m_path, m_bytes);
+        }
+        m_spool = other.m_spool;
+        m_path = std::move(other.m_path);
+        m_bytes = other.m_bytes;
+        m_too_large = other.m_too_large;
+        other.m_spool = nullptr;
+    }
+    return *this;
+}
+
+UserListSpool::Entry::~Entry() {
+    if (m_spool) {
+        m_spool->release(m_path, m_bytes);
+    }
+}
+
+UserListSpool::UserListSpool(std::string directory, std::size_t max_files, std::uint64_t max_bytes)
+    : m_directory(std::move(directory)), m_max_files(max_files), m_max_bytes(max_bytes) {
+    std::filesystem::create_directories(m_directory);
+    // Restos de un proceso que no llegó a borrarlos (users-XXXXXX.json)
+    for (const auto& item : std::filesystem::directory_iterator(m_directory)) {
+        const std::string name = item.path().filename().string();
+        if (name.size() == 17 && name.compare(0, 6, "users-") == 0 && name.compare(12, 5, ".json") == 0) {
+            std::error_code ignored;
+            std::filesystem::remove(item.path(), ignored);
+        }
+    }
+}
+
+UserListSpool::Entry UserListSpool::write(const UserStore& store) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_files >= m_max_files) {
+            return Entry();
+        }
+        ++m_files;
+    }
+    // Desde aquí la Entry lleva la cuenta: si algo lanza, borra y libera
+    Entry entry;
+    entry.m_spool = this;
+
+    // Nombre único creado en exclusiva (mkstemps); RawFile lo reabre para escribir
+#ifdef _WIN32
+    std::string name = m_directory + "/users-XXXXXX";
+    if (_mktemp_s(name.data(), name.size() + 1) != 0) {
+        throw std::system_error(errno, std::generic_category(), "mktemp " + name);
+    }
+    entry.m_path = name + ".json";
+#else
+    entry.m_path = m_directory + "/users-XXXXXX.json";
+    const int fd = ::mkstemps(entry.m_path.data(), 5);
+    if (fd < 0) {
+        const int error = errno;
+        entry.m_path.clear();
+        throw std::system_error(error, std::generic_category(), "mkstemps " + m_directory);
+    }
+    ::close(fd);
+#endif
+    RawFile file(entry.m_path, RawFile::Mode::Truncate);
+
+    // Varias páginas por write(): el buffer queda en unas decenas de KiB. Cada
+    // bloque se descuenta del cupo antes de escribirlo. Si ni con el spool
+    // para él solo cabría, el listado es demasiado grande y no sólo inoportuno.
+    bool too_large = false;
+    auto flush = [&](std::string& buffer) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_bytes + buffer.size() > m_max_bytes) {
+                too_large = entry.m_bytes + buffer.size() > m_max_bytes;
+                return false;
+            }
+            m_bytes += buffer.size();
+            entry.m_bytes += buffer.size();
+        }
+        file.write_all(buffer.data(), buffer.size());
+        buffer.clear();
+        return true;
+    };
+    UserListStream stream(store);
+    std::string buffer;
+    for (auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) {
+        buffer += chunk;
+        if (buffer.size() >= 64 * 1024 && !flush(buffer)) {
+            return refused(too_large);
+        }
+    }
+    if (!flush(buffer)) {
+        return refused(too_large);
+    }
+    return entry;
+}
+
+UserListSpool::Entry UserListSpool::refused(bool too_large) {
+    Entry entry;
+    entry.m_too_large = too_large;
+    return entry;
+}
+
+void UserListSpool::release(const std::string& path, std::uint64_t bytes) {
+    if (!path.empty()) {
+        std::remove(path.c_str());
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_files;
+    m_bytes -= bytes;
+}
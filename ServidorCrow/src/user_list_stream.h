@@ -0,0 +1,99 @@
+#pragma once
+
+#include "user_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Cuerpo de GET /users por trozos, sin tener nunca el listado entero en
+// memoria: pide al motor páginas ordenadas por id con page() y serializa cada
+// una en un buffer que se reutiliza. Concatenados, los trozos son los mismos
+// bytes que users_response() con todos los usuarios:
+//   {"success":true,"users":[{"id":1,"username":"juan"},...]}
+// Lo que se inserte durante el recorrido sale si su id es mayor que el último
+// enviado; nunca se repite ni se desordena un usuario.
+//
+//   UserListStream stream(*users_db);
+//   for (auto chunk = stream.next(); !chunk.empty(); chunk = stream.next()) { ... }
+class UserListStream {
+public:
+    static constexpr std::size_t kDefaultPageSize = 1024;
+
+    explicit UserListStream(const UserStore& store, std::size_t page_size = kDefaultPageSize);
+
+    // Siguiente trozo (válido hasta la próxima llamada); vacío al terminar
+    std::string_view next();
+
+private:
+    enum class State { Head, Users, Done };
+
+    const UserStore& m_store;
+    std::size_t m_page_size;
+    State m_state = State::Head;
+    int m_last_id = 0;
+    bool m_first = true;
+    std::string m_chunk;
+};
+
+// Crow sólo envía por trozos los ficheros (set_static_file_info, de 16 KiB en
+// 16 KiB), así que /users vuelca el stream a un fichero temporal y entrega su
+// ruta. Con un handler que llama a res.end() el envío termina dentro de esa
+// llamada; después se destruye la Entry y el fichero se borra. Eso depende de
+// CrowCpp 1.x (Connection::do_write_static escribe el fichero de forma
+// síncrona); bench_users_send falla si una versión lo difiere y el fichero
+// desaparece antes de enviarse.
+//
+// Para que peticiones concurrentes no llenen el disco, el spool admite como
+// mucho `max_files` listados a la vez y `max_bytes` entre todos; por encima,
+// write() devuelve una Entry vacía. Si es el listado solo el que no cabe en
+// `max_bytes`, la Entry vacía lo indica con too_large(): reintentar no sirve.
+// El directorio es sólo del spool: al crearlo se borran los listados que
+// dejara un proceso anterior.
+class UserListSpool {
+public:
+    // Listado escrito en disco; al destruirse borra el fichero y libera su cupo
+    class Entry {
+    public:
+        Entry() = default;
+        Entry(Entry&& other) noexcept;
+        Entry& operator=(Entry&& other) noexcept;
+        ~Entry();
+
+        explicit operator bool() const { return m_spool != nullptr; }
+        const std::string& path() const { return m_path; }
+        // Vacía porque el listado entero supera max_bytes (no por otros en curso)
+        bool too_large() const { return m_too_large; }
+
+    private:
+        friend class UserListSpool;
+
+        UserListSpool* m_spool = nullptr;
+        std::string m_path;
+        std::uint64_t m_bytes = 0;
+        bool m_too_large = false;
+    };
+
+    UserListSpool(std::string directory, std::size_t max_files, std::uint64_t max_bytes);
+
+    UserListSpool(const UserListSpool&) = delete;
+    UserListSpool& operator=(const UserListSpool&) = delete;
+
+    // Escribe el listado completo (.json). Vacía si se superan los límites
+    // (too_large() distingue el tamaño de la concurrencia); los errores de E/S
+    // se lanzan como std::system_error.
+    Entry write(const UserStore& store);
+
+private:
+    static Entry refused(bool too_large);
+    void release(const std::string& path, std::uint64_t bytes);
+
+    std::string m_directory;
+    std::size_t m_max_files;
+    std::uint64_t m_max_bytes;
+    std::mutex m_mutex;
+    std::size_t m_files = 0;
+    std::uint64_t m_bytes = 0;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "raw_file.h"
+#include "user.h"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Log binario append-only de altas de usuario (write-ahead log).
+//
+// Formato (little-endian):
+//   cabecera: "USERLOG1" | u32 versión | u32 reservado
+//   lote:     u32 0xFFFFFFFF | u32 registros | u32 bytes | u32 crc32(registros) | u32 crc32(lo anterior)
+//             | registros
+//   registro: u32 largo | u32 crc32(payload) | payload
+//   payload:  i32 id | u16 largo username | u16 largo password | bytes
+//
+// append() escribe un lote (group commit) con un único write y un único
+// sync; si falla, recorta lo escrito a medias antes de relanzar. Un lote se
+// acepta o se descarta entero: sus páginas no llegan al disco en orden, así
+// que una caída puede dejar un hueco con registros intactos detrás, todos de
+// un lote que nunca se confirmó. replay() recorta ese último lote, pero lanza
+// si detrás de lo inválido hay un lote completo (corrupción en medio del
+// log: recortar tiraría altas confirmadas).
+class UserLog {
+public:
+    static constexpr std::uint32_t kVersion = 2;  // 1: registros sin marco de lote
+    static constexpr std::size_t kHeaderSize = 16;
+
+    struct ReplayStats {
+        std::uint64_t records = 0;
+        std::uint64_t bytes = 0;           // bytes válidos leídos
+        std::uint64_t truncated_bytes = 0;  // cola descartada (último lote incompleto)
+    };
+
+    // Abre (o crea) el log. Hay que llamar a replay() antes del primer append().
+    explicit UserLog(const std::string& path);
+
+    // Recorre los registros a partir de `from_offset` (0 = desde el principio),
+    // entregándolos en lotes a on_batch, y deja el log listo para añadir.
+    ReplayStats replay(std::uint64_t from_offset, const std::function<void(std::vector<User>&)>& on_batch);
+
+    // Añade el lote y espera a que esté en disco. Si lanza, el lote no queda
+    // en el log (o, si no se pudo recortar, el log rechaza los siguientes)
+    void append(const std::vector<User>& users);
+
+    // Offset del final del último registro durable
+    std::uint64_t end_offset() const;
+
+    const std::string& path() const { return m_file.path(); }
+    std::uint64_t size_on_disk() const { return m_file.size(); }
+
+    // Sólo codifica/decodifica, sin E/S (útil para medir el parseo aislado)
+    static void encode(const User& user, std::string& out);
+    static std::size_t decode(const char* data, std::size_t size, User& user, bool& corrupt);
+
+    // Comprueba la cabecera de un log abierto (p. ej. en sólo lectura); lanza si no es válida
+    static void validate_header(RawFile& file);
+
+    // Lee registros (sueltos o en lotes) de `file` desde `offset` hasta el
+    // final o el primero inválido; devuelve el offset tras el último válido.
+    // Compartido con los snapshots, que usan el mismo formato de registro.
+    static std::uint64_t read_records(RawFile& file, std::uint64_t offset,
+                                      const std::function<void(std::vector<User>&)>& on_batch,
+                                      std::uint64_t& records);
+
+private:
+    // Lote completo (marco y registros) en [data, data + size): bytes que ocupa,
+    // 0 si faltan bytes o es inválido (corrupt distingue los dos casos)
+    static std::size_t decode_batch(const char* data, std::size_t size, std::vector<User>& users, bool& corrupt);
+    // ¿Algún lote completo empieza en `offset` o después?
+    static bool valid_batch_from(RawFile& file, std::uint64_t offset);
+
+    mutable std::mutex m_mutex;
+    RawFile m_file;
+    std::uint64_t m_end = kHeaderSize;
+    std::string m_buffer;  // reutilizado entre appends
+    bool m_failed = false;
+};
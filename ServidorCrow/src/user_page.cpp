@@ -0,0 +1,76 @@
+#include "user_page.h"
+
+#include "base64url.h"
+#include "json_writer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr unsigned char kCursorVersion = 1;
+constexpr std::size_t kCursorBytes = 6;  // múltiplo de 3: 8 caracteres sin relleno
+
+unsigned char cursor_check(const unsigned char* bytes) {
+    unsigned char check = 0x5a;
+    for (std::size_t i = 0; i + 1 < kCursorBytes; ++i) {
+        check = static_cast<unsigned char>((check ^ bytes[i]) * 31);
+    }
+    return check;
+}
+
+}  // namespace
+
+std::string encode_user_cursor(int last_id) {
+    const auto id = static_cast<std::uint32_t>(last_id);
+    unsigned char bytes[kCursorBytes] = {kCursorVersion, static_cast<unsigned char>(id >> 24),
+                                         static_cast<unsigned char>(id >> 16), static_cast<unsigned char>(id >> 8),
+                                         static_cast<unsigned char>(id)};
+    bytes[kCursorBytes - 1] = cursor_check(bytes);
+    std::string cursor;
+    base64url_encode(bytes, sizeof(bytes), cursor);
+    return cursor;
+}
+
+bool decode_user_cursor(std::string_view cursor, int& last_id) {
+    std::string decoded;
+    if (cursor.size() != base64url_encoded_size(kCursorBytes) || !base64url_decode(cursor, decoded) ||
+        decoded.size() != kCursorBytes) {
+        return false;
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(decoded.data());
+    if (bytes[0] != kCursorVersion || bytes[kCursorBytes - 1] != cursor_check(bytes)) {
+        return false;
+    }
+    const std::uint32_t id = std::uint32_t{bytes[1]} << 24 | std::uint32_t{bytes[2]} << 16 |
+                             std::uint32_t{bytes[3]} << 8 | bytes[4];
+    last_id = static_cast<int>(id);
+    return last_id >= 0;
+}
+
+std::string user_page_response(const UserStore& store, int after_id, std::size_t limit) {
+    // Uno de más para saber si hay otra página sin una consulta aparte
+    limit = std::max<std::size_t>(limit, 1);
+    std::vector<User> users = store.page(after_id, limit + 1);
+    const bool more = users.size() > limit;
+    if (more) {
+        users.pop_back();
+    }
+
+    std::size_t size = 64;
+    for (const User& user : users) {
+        size += 34 + user.username.size();
+    }
+    JsonWriter out(size);
+    out.begin_object();
+    if (more) {
+        out.key("next_cursor").value(encode_user_cursor(users.back().id));
+    }
+    out.key("success").value(true).key("users").begin_array();
+    for (const User& user : users) {
+        out.begin_object().key("id").value(user.id).key("username").value(user.username).end_object();
+    }
+    out.end_array().end_object();
+    return out.take();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "user_store.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// GET /users?limit=N&cursor=C: paginación por cursor sobre el orden por id.
+//
+// El cursor es el último id de la página anterior, codificado (opaco para el
+// cliente). Cada página pide a UserStore::page() los `limit` siguientes, así
+// que cuesta O(limit) en cualquier posición, sin OFFSET que recorra lo
+// anterior. Las altas concurrentes no desplazan nada: nunca se repite ni se
+// salta un usuario que ya existía; uno nuevo sale en una página posterior si
+// su id es mayor que el cursor (con bloques de ids por hilo, puede no serlo).
+//
+//   {"next_cursor":"AQAAAGQh","success":true,"users":[{"id":1,"username":"juan"},...]}
+// next_cursor falta en la última página.
+
+// "AQAAAGQh": versión, id en big-endian y un byte de control, en base64url
+std::string encode_user_cursor(int last_id);
+
+// false si el cursor no lo generó encode_user_cursor
+bool decode_user_cursor(std::string_view cursor, int& last_id);
+
+// Cuerpo de la página de hasta `limit` usuarios con id > after_id
+std::string user_page_response(const UserStore& store, int after_id, std::size_t limit);
@@ -0,0 +1,94 @@
+#include "user_snapshot.h"
+
+#include "raw_file.h"
+#include "user_log.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'S', 'E', 'R', 'S', 'N', 'P', '1'};
+constexpr std::size_t kHeaderSize = 32;
+constexpr std::size_t kWriteChunk = 4 << 20;
+
+std::string make_header(std::uint64_t log_offset, std::uint64_t records) {
+    std::string header(kHeaderSize, '\0');
+    const std::uint32_t version = UserSnapshot::kVersion;
+    std::memcpy(&header[0], kMagic, sizeof(kMagic));
+    std::memcpy(&header[8], &version, sizeof(version));
+    std::memcpy(&header[16], &log_offset, sizeof(log_offset));
+    std::memcpy(&header[24], &records, sizeof(records));
+    return header;
+}
+
+}  // namespace
+
+UserSnapshot::Info UserSnapshot::write(const std::string& path, const MemoryUserStore& store,
+                                       std::uint64_t log_offset) {
+    const std::string tmp = path + ".tmp";
+    RawFile file(tmp, RawFile::Mode::Truncate);
+
+    Info info;
+    info.log_offset = log_offset;
+
+    std::string buffer = make_header(log_offset, 0);  // el número real se escribe al final
+    buffer.reserve(kWriteChunk + 4096);
+    store.for_each_shard([&](const std::vector<const User*>& records) {
+        for (const User* user : records) {
+            UserLog::encode(*user, buffer);
+            if (buffer.size() >= kWriteChunk) {
+                file.write_all(buffer.data(), buffer.size());
+                info.bytes += buffer.size();
+                buffer.clear();
+            }
+        }
+        info.records += records.size();
+    });
+    file.write_all(buffer.data(), buffer.size());
+    info.bytes += buffer.size();
+
+    const std::string header = make_header(log_offset, info.records);
+    file.seek(0);
+    file.write_all(header.data(), header.size());
+    file.sync();
+    file.close();
+
+    RawFile::replace(tmp, path);
+    RawFile::sync_directory(path);
+    return info;
+}
+
+std::optional<UserSnapshot::Info> UserSnapshot::load(const std::string& path, std::uint64_t log_size,
+                                                     const std::function<void(std::vector<User>&)>& on_batch) {
+    if (!RawFile::exists(path)) {
+        return std::nullopt;
+    }
+
+    RawFile file(path, RawFile::Mode::Read);
+    char header[kHeaderSize];
+    if (file.read(header, kHeaderSize) != kHeaderSize || std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("UserSnapshot: " + path + " no es un snapshot de usuarios");
+    }
+    std::uint32_t version;
+    std::memcpy(&version, header + 8, sizeof(version));
+    if (version != kVersion) {
+        throw std::runtime_error("UserSnapshot: versión no soportada en " + path);
+    }
+
+    Info info;
+    std::uint64_t expected;
+    std::memcpy(&info.log_offset, header + 16, sizeof(info.log_offset));
+    std::memcpy(&expected, header + 24, sizeof(expected));
+    if (info.log_offset > log_size) {
+        throw std::runtime_error("UserSnapshot: " + path + " llega al offset " + std::to_string(info.log_offset) +
+                                 " del log, que sólo tiene " + std::to_string(log_size) + " bytes");
+    }
+
+    const std::uint64_t end = UserLog::read_records(file, kHeaderSize, on_batch, info.records);
+    info.bytes = end;
+    if (info.records != expected || end != file.size()) {
+        throw std::runtime_error("UserSnapshot: " + path + " está incompleto o corrupto");
+    }
+    return info;
+}
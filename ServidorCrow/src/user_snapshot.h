@@ -0,0 +1,40 @@
+#pragma once
+
+#include "memory_user_store.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Snapshot binario del almacén de usuarios para arrancar sin reproducir
+// todo el log.
+//
+// Formato: "USERSNP1" | u32 versión | u32 reservado | u64 offset del log |
+//          u64 número de registros | registros (mismo formato que UserLog)
+//
+// `log_offset` es el final del log en el momento de empezar el snapshot:
+// todo lo anterior está en el snapshot, así que al arrancar basta con
+// reproducir el log desde ahí (lo posterior puede estar repetido, y la
+// inserción idempotente lo descarta).
+class UserSnapshot {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    struct Info {
+        std::uint64_t log_offset = 0;
+        std::uint64_t records = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    // Escribe en `path`.tmp, sincroniza, renombra y sincroniza el directorio:
+    // un snapshot a medias nunca sustituye al anterior
+    static Info write(const std::string& path, const MemoryUserStore& store, std::uint64_t log_offset);
+
+    // Carga el snapshot en lotes; nullopt si no existe. Lanza si está corrupto
+    // o si su offset pasa de `log_size` (el log no es el del snapshot: se ha
+    // restaurado o recortado), en ese caso antes de entregar ningún registro.
+    static std::optional<Info> load(const std::string& path, std::uint64_t log_size,
+                                    const std::function<void(std::vector<User>&)>& on_batch);
+};
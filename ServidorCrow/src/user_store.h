@@ -0,0 +1,56 @@
+#pragma once
+
+#include "user.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Interfaz común de los motores de almacenamiento de usuarios.
+// Los handlers de Crow sólo hablan con esta interfaz, así que cambiar de
+// motor no toca las rutas. Todas las implementaciones deben ser seguras
+// para llamarse desde varios hilos a la vez.
+class UserStore {
+public:
+    virtual ~UserStore() = default;
+
+    // Nombre corto del motor (logs y benchmarks)
+    virtual const char* name() const = 0;
+
+    virtual std::optional<User> find_by_username(std::string_view username) const = 0;
+    virtual std::optional<User> find_by_id(int id) const = 0;
+
+    // Inserta el usuario si el username no existe. Devuelve false si ya estaba.
+    virtual bool insert_if_absent(const User& user) = 0;
+
+    // Inserta varios usuarios de una vez (una transacción o un fsync en los
+    // motores durables). Devuelve, por posición, lo mismo que insert_if_absent.
+    virtual std::vector<bool> insert_batch(const std::vector<User>& users) {
+        std::vector<bool> inserted;
+        inserted.reserve(users.size());
+        for (const auto& user : users) {
+            inserted.push_back(insert_if_absent(user));
+        }
+        return inserted;
+    }
+
+    // false si el motor no puede guardar estas credenciales aunque el username
+    // esté libre (p. ej. huecos de tamaño fijo); /register responde 400
+    virtual bool accepts(std::string_view /*username*/, std::string_view /*password*/) const { return true; }
+
+    // true si un insert confirmado sobrevive a un reinicio
+    virtual bool durable() const { return false; }
+
+    // Hasta `limit` usuarios con id > after_id, ordenados por id
+    virtual std::vector<User> page(int after_id, std::size_t limit) const = 0;
+
+    // Recorre todos los usuarios en un orden no especificado
+    virtual void for_each(const std::function<void(const User&)>& fn) const = 0;
+
+    virtual std::size_t size() const = 0;
+
+    // Mayor id almacenado (0 si está vacío); sirve para reanudar el IdAllocator
+    virtual int max_id() const = 0;
+};
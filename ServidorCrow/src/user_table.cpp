@@ -0,0 +1,161 @@
+#include "user_table.h"
+
+#include "raw_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'S', 'R', 'T', 'B', 'L', '0', '1'};
+
+std::uint64_t bucket_count_for(std::uint64_t records) {
+    std::uint64_t n = 16;
+    while (n < records * 2) {
+        n <<= 1;
+    }
+    return n;
+}
+
+}  // namespace
+
+UserTable::UserTable(const std::string& path) : m_file(path) {
+    const std::size_t size = m_file.size();
+    if (size < sizeof(UserTableHeader)) {
+        throw std::runtime_error("UserTable: " + path + " es demasiado pequeño");
+    }
+
+    m_header = reinterpret_cast<const UserTableHeader*>(m_file.data());
+    const UserTableHeader& h = *m_header;
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("UserTable: " + path + " no es una tabla de usuarios");
+    }
+    if (h.version != kVersion || h.record_size != sizeof(UserTableRecord)) {
+        throw std::runtime_error("UserTable: versión no soportada en " + path + "; reconstruir con user_table_build");
+    }
+    // Al menos un cubo vacío (si no, find no terminaría) y cuentas que no
+    // desborden al multiplicar por el tamaño de registro o cubo
+    const bool bad_counts = h.bucket_count == 0 || (h.bucket_count & (h.bucket_count - 1)) != 0 ||
+                            h.bucket_count <= h.record_count || h.record_count > UINT32_MAX;
+    const bool bad_layout = bad_counts || h.records_offset % alignof(UserTableRecord) != 0 ||
+                            h.index_offset % alignof(UserTableBucket) != 0 || h.records_offset > size ||
+                            h.record_count > (size - h.records_offset) / sizeof(UserTableRecord) ||
+                            h.records_offset + h.record_count * sizeof(UserTableRecord) > h.index_offset ||
+                            h.index_offset > size ||
+                            h.bucket_count > (size - h.index_offset) / sizeof(UserTableBucket);
+    if (bad_layout) {
+        throw std::runtime_error("UserTable: " + path + " está truncada o corrupta");
+    }
+
+    m_records = reinterpret_cast<const UserTableRecord*>(m_file.data() + h.records_offset);
+    m_buckets = reinterpret_cast<const UserTableBucket*>(m_file.data() + h.index_offset);
+}
+
+std::uint64_t UserTable::hash(std::string_view username) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : username) {
+        h = (h ^ c) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+// El índice y los registros no se validan al abrir (sería leer la tabla
+// entera); se comprueba lo que toca cada búsqueda, y una tabla corrupta lanza
+// en vez de leer fuera del fichero o dar vueltas sin fin.
+const UserTableRecord* UserTable::find(std::string_view username) const {
+    const std::uint64_t h = hash(username);
+    const auto tag = static_cast<std::uint32_t>(h >> 32);
+    const std::uint64_t mask = m_header->bucket_count - 1;
+
+    std::uint64_t i = h & mask;
+    for (std::uint64_t probes = 0; probes < m_header->bucket_count; ++probes, i = (i + 1) & mask) {
+        const UserTableBucket& bucket = m_buckets[i];
+        if (bucket.record == 0) {
+            return nullptr;
+        }
+        if (bucket.record > m_header->record_count) {
+            throw std::runtime_error("UserTable: cubo con un registro fuera de la tabla");
+        }
+        if (bucket.tag == tag) {
+            const UserTableRecord& record = m_records[bucket.record - 1];
+            if (record.username_len <= UserTableRecord::kUsernameSlot && record.name() == username) {
+                return &record;
+            }
+        }
+    }
+    throw std::runtime_error("UserTable: índice sin cubos vacíos");
+}
+
+const UserTableRecord* UserTable::find(int id) const {
+    const std::size_t i = upper_bound(id - 1);
+    return i < size() && m_records[i].id == id ? &m_records[i] : nullptr;
+}
+
+std::size_t UserTable::upper_bound(int after_id) const {
+    const UserTableRecord* end = m_records + size();
+    const UserTableRecord* it = std::upper_bound(
+        m_records, end, after_id, [](int id, const UserTableRecord& record) { return id < record.id; });
+    return static_cast<std::size_t>(it - m_records);
+}
+
+User UserTable::to_user(const UserTableRecord& record) {
+    if (record.username_len > UserTableRecord::kUsernameSlot || record.password_len > UserTableRecord::kPasswordSlot) {
+        throw std::runtime_error("UserTable: registro " + std::to_string(record.id) + " con longitudes corruptas");
+    }
+    return User{std::string(record.username, record.username_len),
+                std::string(record.password, record.password_len), record.id};
+}
+
+bool UserTable::fits(std::string_view username, std::string_view password) {
+    return username.size() <= UserTableRecord::kUsernameSlot && password.size() <= UserTableRecord::kPasswordSlot;
+}
+
+void UserTable::build(const std::string& path, std::vector<User> users, std::uint64_t log_offset) {
+    std::sort(users.begin(), users.end(), [](const User& a, const User& b) { return a.id < b.id; });
+
+    UserTableHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.record_size = sizeof(UserTableRecord);
+    header.record_count = users.size();
+    header.bucket_count = bucket_count_for(users.size());
+    header.records_offset = sizeof(UserTableHeader);
+    header.index_offset = header.records_offset + users.size() * sizeof(UserTableRecord);
+    header.log_offset = log_offset;
+    header.max_id = users.empty() ? 0 : users.back().id;
+
+    std::vector<UserTableRecord> records(users.size());
+    std::vector<UserTableBucket> buckets(header.bucket_count);
+    const std::uint64_t mask = header.bucket_count - 1;
+
+    for (std::size_t i = 0; i < users.size(); ++i) {
+        const User& user = users[i];
+        if (!fits(user)) {
+            throw std::length_error("UserTable: el usuario " + user.username + " no cabe en los huecos fijos");
+        }
+        UserTableRecord& r = records[i];
+        r.id = user.id;
+        r.username_len = static_cast<std::uint8_t>(user.username.size());
+        r.password_len = static_cast<std::uint8_t>(user.password.size());
+        std::memcpy(r.username, user.username.data(), user.username.size());
+        std::memcpy(r.password, user.password.data(), user.password.size());
+
+        const std::uint64_t h = hash(user.username);
+        std::uint64_t b = h & mask;
+        while (buckets[b].record != 0) {
+            b = (b + 1) & mask;
+        }
+        buckets[b] = UserTableBucket{static_cast<std::uint32_t>(h >> 32), static_cast<std::uint32_t>(i + 1)};
+    }
+
+    const std::string tmp = path + ".tmp";
+    {
+        RawFile file(tmp, RawFile::Mode::Truncate);
+        file.write_all(&header, sizeof(header));
+        file.write_all(records.data(), records.size() * sizeof(UserTableRecord));
+        file.write_all(buckets.data(), buckets.size() * sizeof(UserTableBucket));
+        file.sync();
+    }
+    RawFile::replace(tmp, path);
+}
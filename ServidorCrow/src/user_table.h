@@ -0,0 +1,88 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "user.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tabla de usuarios en disco con disposición fija, para servirse con mmap
+// sin deserializar nada al arrancar.
+//
+// Disposición: cabecera (64 bytes) | registros de 128 bytes ordenados por id |
+// índice hash de direccionamiento abierto (cubos de 8 bytes, potencia de 2).
+// Cada cubo guarda una etiqueta del hash y la posición del registro, así que
+// un /login toca un cubo y un registro. Todos los enteros en little-endian.
+struct UserTableHeader {
+    char magic[8];            // "USRTBL01"
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint64_t record_count;
+    std::uint64_t bucket_count;
+    std::uint64_t records_offset;
+    std::uint64_t index_offset;
+    std::uint64_t log_offset;  // final del log de usuarios ya incluido en la tabla
+    std::int32_t max_id;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(UserTableHeader) == 64, "cabecera de 64 bytes");
+
+struct UserTableRecord {
+    static constexpr std::size_t kUsernameSlot = 56;
+    static constexpr std::size_t kPasswordSlot = 64;
+
+    std::int32_t id;
+    std::uint8_t username_len;
+    std::uint8_t password_len;
+    std::uint16_t reserved;
+    char username[kUsernameSlot];
+    char password[kPasswordSlot];
+
+    std::string_view name() const { return {username, username_len}; }
+};
+static_assert(sizeof(UserTableRecord) == 128, "registro de 128 bytes");
+
+struct UserTableBucket {
+    std::uint32_t tag;     // 32 bits altos del hash
+    std::uint32_t record;  // posición del registro + 1; 0 = vacío
+};
+
+class UserTable {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    // Proyecta la tabla y valida la cabecera; lanza si no es válida
+    explicit UserTable(const std::string& path);
+
+    // Lanza si el índice o el registro que toca están corruptos
+    const UserTableRecord* find(std::string_view username) const;
+    const UserTableRecord* find(int id) const;
+
+    // Primer registro con id > after_id (búsqueda binaria)
+    std::size_t upper_bound(int after_id) const;
+
+    const UserTableRecord& record(std::size_t i) const { return m_records[i]; }
+    std::size_t size() const { return m_header->record_count; }
+    std::uint64_t log_offset() const { return m_header->log_offset; }
+    int max_id() const { return m_header->max_id; }
+
+    // Lanza si las longitudes del registro no caben en sus huecos
+    static User to_user(const UserTableRecord& record);
+    static bool fits(const User& user) { return fits(user.username, user.password); }
+    static bool fits(std::string_view username, std::string_view password);
+
+    // Escribe la tabla en `path`.tmp y la renombra. Lanza si algún usuario
+    // no cabe en los huecos fijos (ver fits()).
+    static void build(const std::string& path, std::vector<User> users, std::uint64_t log_offset);
+
+    // Hash estable entre compilaciones (FNV-1a de 64 bits)
+    static std::uint64_t hash(std::string_view username);
+
+private:
+    MappedFile m_file;
+    const UserTableHeader* m_header = nullptr;
+    const UserTableRecord* m_records = nullptr;
+    const UserTableBucket* m_buckets = nullptr;
+};
@@ -0,0 +1,97 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+struct WorkerPool::Job {
+    const Range* fn;
+    std::size_t count;
+    std::size_t grain;
+    std::size_t chunks;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+WorkerPool::WorkerPool(std::size_t threads) {
+    for (std::size_t i = 1; i < threads; ++i) {
+        m_workers.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::parallel_for(std::size_t count, std::size_t grain, const Range& fn) {
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    if (chunks <= 1 || m_workers.empty()) {
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            fn(begin, std::min(begin + grain, count));
+        }
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->fn = &fn;
+    job->count = count;
+    job->grain = grain;
+    job->chunks = chunks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(job);
+    }
+    m_cv.notify_all();
+
+    run_chunks(*job);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.erase(std::remove(m_jobs.begin(), m_jobs.end(), job), m_jobs.end());
+    }
+
+    // Los bloques que tomaron otros hilos pueden seguir en marcha
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&] { return job->done.load(std::memory_order_acquire) == chunks; });
+}
+
+void WorkerPool::worker_loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+        if (m_stopping) {
+            return;
+        }
+        std::shared_ptr<Job> job = m_jobs.front();
+        lock.unlock();
+
+        run_chunks(*job);
+
+        // Sin bloques por repartir: deja de anunciarse (si nadie lo quitó ya)
+        lock.lock();
+        if (!m_jobs.empty() && m_jobs.front() == job) {
+            m_jobs.pop_front();
+        }
+    }
+}
+
+void WorkerPool::run_chunks(Job& job) {
+    std::size_t chunk;
+    while ((chunk = job.next.fetch_add(1, std::memory_order_relaxed)) < job.chunks) {
+        const std::size_t begin = chunk * job.grain;
+        (*job.fn)(begin, std::min(begin + job.grain, job.count));
+        if (job.done.fetch_add(1, std::memory_order_acq_rel) + 1 == job.chunks) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.finished.notify_all();
+        }
+    }
+}
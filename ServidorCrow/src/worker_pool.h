@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Hilos fijos para repartir un trabajo grande (p. ej. un lote de tokens) entre
+// núcleos sin crear hilos por petición.
+//
+// parallel_for parte [0, count) en bloques de `grain` (fn recibe siempre un
+// bloque, nunca más) que se reparten con un contador atómico; el hilo que
+// llama también trabaja y vuelve cuando todos los bloques han terminado.
+// Varias peticiones pueden usar el pool a la vez: los trabajos se atienden en
+// orden de llegada y cada uno avanza al menos con su propio hilo, así que uno
+// grande no bloquea a uno pequeño.
+class WorkerPool {
+public:
+    using Range = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // threads: hilos en total contando el que llama (1 = todo en línea)
+    explicit WorkerPool(std::size_t threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void parallel_for(std::size_t count, std::size_t grain, const Range& fn);
+
+    std::size_t threads() const { return m_workers.size() + 1; }
+
+private:
+    struct Job;
+
+    void worker_loop();
+    static void run_chunks(Job& job);
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<Job>> m_jobs;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
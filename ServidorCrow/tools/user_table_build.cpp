@@ -0,0 +1,76 @@
+// Convierte el log (y opcionalmente el último snapshot) en una UserTable
+// para servir /login con mmap (USER_TABLE_PATH).
+// Uso: user_table_build <users.log> <users.table> [users.snap]
+//
+// Sólo lee el log, así que puede ejecutarse con el servidor en marcha: la
+// tabla recuerda hasta dónde llegó y el servidor reproduce el resto al arrancar.
+
+#include "memory_user_store.h"
+#include "raw_file.h"
+#include "user_log.h"
+#include "user_snapshot.h"
+#include "user_table.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Uso: " << argv[0] << " <users.log> <users.table> [users.snap]" << std::endl;
+        return 2;
+    }
+    const std::string log_path = argv[1];
+    const std::string table_path = argv[2];
+    const std::string snapshot_path = argc > 3 ? argv[3] : "";
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const auto start = std::chrono::steady_clock::now();
+
+    try {
+        MemoryUserStore store;
+        auto load = [&](std::vector<User>& batch) { store.bulk_load(batch, threads); };
+
+        RawFile log(log_path, RawFile::Mode::Read);
+        UserLog::validate_header(log);
+
+        std::uint64_t offset = UserLog::kHeaderSize;
+        if (!snapshot_path.empty()) {
+            if (auto info = UserSnapshot::load(snapshot_path, log.size(), load)) {
+                offset = info->log_offset;
+                std::cout << "📸 Snapshot: " << info->records << " usuarios" << std::endl;
+            }
+        }
+
+        std::uint64_t records = 0;
+        const std::uint64_t end = UserLog::read_records(log, offset, load, records);
+        std::cout << "📜 Log: " << records << " registros hasta el offset " << end << std::endl;
+
+        std::vector<User> users;
+        users.reserve(store.size());
+        bool fits = true;
+        store.for_each_shard([&](const std::vector<const User*>& shard) {
+            for (const User* user : shard) {
+                if (!UserTable::fits(*user)) {
+                    std::cerr << "❌ No cabe en la tabla (username <= " << UserTableRecord::kUsernameSlot
+                              << ", password <= " << UserTableRecord::kPasswordSlot << " bytes): "
+                              << user->username << std::endl;
+                    fits = false;
+                }
+                users.push_back(*user);
+            }
+        });
+        if (!fits) {
+            return 1;
+        }
+
+        const std::size_t count = users.size();
+        UserTable::build(table_path, std::move(users), end);
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "✅ Tabla " << table_path << ": " << count << " usuarios en " << seconds << " s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -189,10 +189,18 @@ void MainWindow::onLoginClicked()
 
 void MainWindow::onViewUsersClicked()
 {
-    logMessage("Obteniendo lista de usuarios...", "blue");
+    logMessage(m_usersCursor.isEmpty() ? "Obteniendo lista de usuarios..." : "Obteniendo más usuarios...", "blue");
     showProgress(true);
 
-    QNetworkRequest request(QUrl(m_baseUrl + "/users"));
+    // Una página por clic: el servidor devuelve next_cursor si quedan más
+    QUrl url(m_baseUrl + "/users");
+    QUrlQuery query;
+    query.addQueryItem("limit", "100");
+    if (!m_usersCursor.isEmpty()) {
+        query.addQueryItem("cursor", m_usersCursor);
+    }
+    url.setQuery(query);
+    QNetworkRequest request(url);
 
     QNetworkReply* reply = m_networkManager->get(request);
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
@@ -302,11 +310,18 @@ void MainWindow::onViewUsersFinished(QNetworkReply* reply)
                 logMessage(QString("  • ID: %1 - Usuario: %2").arg(id).arg(username), "black");
             }
 
+            m_usersCursor = obj["next_cursor"].toString();
+            if (!m_usersCursor.isEmpty()) {
+                logMessage("Hay más usuarios: pulsa de nuevo para ver la siguiente página", "blue");
+            }
+
         } else {
+            m_usersCursor.clear();
             logMessage("Error obteniendo usuarios", "red");
         }
 
     } else {
+        m_usersCursor.clear();
         logMessage("Error de conexión: " + reply->errorString(), "red");
     }
 }
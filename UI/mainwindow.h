@@ -12,6 +12,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QUrlQuery>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -55,6 +56,7 @@ private:
     QNetworkAccessManager* m_networkManager;
     QString m_baseUrl;
     QString m_currentToken;
+    QString m_usersCursor;  // siguiente página de /users (vacío: empezar por la primera)
 
 public:
     MainWindow(QWidget *parent = nullptr);